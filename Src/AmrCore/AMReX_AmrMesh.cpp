@@ -356,6 +356,9 @@ AmrMesh::InitAmrMesh (int max_level_in, const Vector<int>& n_cell_in,
 
     pp.query("check_input", check_input);
 
+    pp.query("parallel_cluster", use_parallel_cluster);
+    pp.query("compress_tags", use_compressed_tags);
+
     finest_level = -1;
 
     if (check_input) checkInput();
@@ -689,13 +692,26 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
         //
         tags.setVal(p_n_comp[levc],TagBox::CLEAR);
         //
-        // Create initial cluster containing all tagged points.
+        // Create initial cluster containing all tagged points.  With
+        // parallel clustering, each process only keeps its own tags.
         //
 	Vector<IntVect> tagvec;
-	tags.collate(tagvec);
+        CompressedTags ctags;
+        Long ntags;
+        if (use_parallel_cluster) {
+            tags.local_collate(tagvec);
+            ntags = tagvec.size();
+            ParallelDescriptor::ReduceLongSum(ntags);
+        } else if (use_compressed_tags) {
+            tags.collate(ctags);
+            ntags = ctags.numTags();
+        } else {
+            tags.collate(tagvec);
+            ntags = tagvec.size();
+        }
         tags.clear();
 
-        if (tagvec.size() > 0)
+        if (ntags > 0)
         {
             //
             // Created new level, now generate efficient grids.
@@ -705,13 +721,13 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
             }
 
             if (levf > useFixedUpToLevel()) {
-                BoxList new_bx;
-                if (ParallelDescriptor::IOProcessor()) {
-                    BL_PROFILE("AmrMesh-cluster");
-                    //
-                    // Construct initial cluster.
-                    //
-                    ClusterList clist(&tagvec[0], tagvec.size());
+                //
+                // Chop the initial cluster clist and return efficient properly
+                // nested grids at level levc, in units of the blocking factor.
+                //
+                auto cluster = [&] (ClusterList& clist) -> BoxList
+                {
+                    BoxList cl_bl;
                     if (use_new_chop) {
                         clist.new_chop(grid_eff);
                     } else {
@@ -725,16 +741,54 @@ AmrMesh::MakeNewGrids (int lbase, Real time, int& new_finest, Vector<BoxArray>&
                     // Efficient properly nested Clusters have been constructed
                     // now generate list of grids at level levf.
                     //
-                    clist.boxList(new_bx);
-                    new_bx.refine(bf_lev[levc]);
-                    new_bx.simplify();
+                    clist.boxList(cl_bl);
+                    cl_bl.refine(bf_lev[levc]);
+                    cl_bl.simplify();
 
-                    if (new_bx.size()>0) {
+                    if (cl_bl.size()>0) {
                         // Chop new grids outside domain
-                        new_bx.intersect(Geom(levc).Domain());
+                        cl_bl.intersect(Geom(levc).Domain());
+                    }
+                    return cl_bl;
+                };
+
+                BoxList new_bx;
+                if (use_parallel_cluster) {
+                    BL_PROFILE("AmrMesh-parallel-cluster");
+                    if (!tagvec.empty()) {
+                        ClusterList clist(tagvec.data(), tagvec.size());
+                        new_bx = cluster(clist);
+                    }
+                    //
+                    // The tags of different processes are disjoint, so the
+                    // efficiency of the union of the grids is at least
+                    // grid_eff.  Only the grids are exchanged.  Overlaps
+                    // between grids from different processes are removed,
+                    // and since all grids are aligned to the blocking factor
+                    // so are the pieces.  Every process gets the same list.
+                    //
+                    amrex::AllGatherBoxes(new_bx.data());
+                    if (new_bx.size() > 1) {
+                        BoxArray ba(std::move(new_bx));
+                        ba.removeOverlap();
+                        new_bx = ba.boxList();
+                    }
+                } else {
+                    if (ParallelDescriptor::IOProcessor()) {
+                        BL_PROFILE("AmrMesh-cluster");
+                        //
+                        // Construct initial cluster.
+                        //
+                        if (use_compressed_tags) {
+                            ClusterList clist(ctags);
+                            new_bx = cluster(clist);
+                        } else {
+                            ClusterList clist(tagvec.data(), tagvec.size());
+                            new_bx = cluster(clist);
+                        }
                     }
+                    new_bx.Bcast();  // Broadcast the new BoxList to other processes
                 }
-                new_bx.Bcast();  // Broadcast the new BoxList to other processes
 
                 //
                 // Refine up to levf.
@@ -1041,6 +1095,8 @@ std::ostream& operator<< (std::ostream& os, AmrMesh const& amr_mesh)
     os << "  refine_grid_layout = " << amr_mesh.refine_grid_layout << "\n";
     os << "  check_input = " << amr_mesh.check_input  << "\n";
     os << "  use_new_chop = " << amr_mesh.use_new_chop << "\n";
+    os << "  use_parallel_cluster = " << amr_mesh.use_parallel_cluster << "\n";
+    os << "  use_compressed_tags = " << amr_mesh.use_compressed_tags << "\n";
     os << "  iterate_on_new_grids = " << amr_mesh.iterate_on_new_grids << "\n";
     return os;
 }
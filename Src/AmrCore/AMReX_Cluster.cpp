@@ -3,6 +3,7 @@
 #include <cmath>
 #include <AMReX_Cluster.H>
 #include <AMReX_BoxDomain.H>
+#include <AMReX_TagBox.H>
 #include <AMReX_Vector.H>
 #include <AMReX_Array.H>
 #include <AMReX_BLProfiler.H>
@@ -453,6 +454,14 @@ ClusterList::ClusterList (IntVect* pts, Long len)
     lst.push_back(new Cluster(pts,len));
 }
 
+ClusterList::ClusterList (const CompressedTags& tags)
+{
+    tags.unpack(m_pts);
+    if (!m_pts.empty()) {
+        lst.push_back(new Cluster(m_pts.data(), m_pts.size()));
+    }
+}
+
 ClusterList::~ClusterList ()
 {
     for (std::list<Cluster*>::iterator cli = lst.begin(), End = lst.end();
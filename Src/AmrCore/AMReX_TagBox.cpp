@@ -577,19 +577,25 @@ TagBoxArray::local_collate_gpu (Vector<IntVect>& v) const
 #endif
 
 void
-TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
+TagBoxArray::local_collate (Vector<IntVect>& v) const
 {
-    BL_PROFILE("TagBoxArray::collate()");
-
-    Vector<IntVect> TheLocalCollateSpace;
 #ifdef AMREX_USE_GPU
     if (Gpu::inLaunchRegion()) {
-        local_collate_gpu(TheLocalCollateSpace);
+        local_collate_gpu(v);
     } else
 #endif
     {
-        local_collate_cpu(TheLocalCollateSpace);
+        local_collate_cpu(v);
     }
+}
+
+void
+TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate()");
+
+    Vector<IntVect> TheLocalCollateSpace;
+    local_collate(TheLocalCollateSpace);
 
     Long count = TheLocalCollateSpace.size();
 
@@ -642,6 +648,154 @@ TagBoxArray::collate (Vector<IntVect>& TheGlobalCollateSpace) const
 #endif
 }
 
+void
+CompressedTags::pack (const IntVect* p, Long n)
+{
+    if (n <= 0) return;
+    AMREX_ALWAYS_ASSERT(n <= static_cast<Long>(std::numeric_limits<int>::max()));
+
+    IntVect lo = p[0];
+    IntVect hi = p[0];
+    for (Long i = 1; i < n; ++i) {
+        lo.min(p[i]);
+        hi.max(p[i]);
+    }
+    const Box bx(lo,hi);
+    const Long nwords = (bx.numPts()+31)/32;
+
+    m_data.push_back(static_cast<int>(n));
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_data.push_back(lo[idim]);
+    }
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_data.push_back(hi[idim]);
+    }
+
+    if (nwords <= n*AMREX_SPACEDIM) {
+        Long offset = m_data.size();
+        m_data.resize(offset+nwords, 0);
+        for (Long i = 0; i < n; ++i) {
+            const Long ibit = bx.index(p[i]);
+            unsigned int w = static_cast<unsigned int>(m_data[offset+ibit/32]);
+            w |= 1u << (ibit%32);
+            m_data[offset+ibit/32] = static_cast<int>(w);
+        }
+    } else {
+        for (Long i = 0; i < n; ++i) {
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_data.push_back(p[i][idim]);
+            }
+        }
+    }
+
+    m_numtags += n;
+}
+
+void
+CompressedTags::unpack (Vector<IntVect>& v) const
+{
+    v.reserve(v.size()+m_numtags);
+
+    Long pos = 0;
+    const Long N = m_data.size();
+    while (pos < N)
+    {
+        const Long n = m_data[pos++];
+        IntVect lo, hi;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            lo[idim] = m_data[pos++];
+        }
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            hi[idim] = m_data[pos++];
+        }
+        const Box bx(lo,hi);
+        const Long nwords = (bx.numPts()+31)/32;
+
+        if (nwords <= n*AMREX_SPACEDIM) {
+            const int* words = m_data.data() + pos;
+            Long ibit = 0;
+            AMREX_LOOP_3D(bx, i, j, k,
+            {
+                const unsigned int w = static_cast<unsigned int>(words[ibit/32]);
+                if ((w >> (ibit%32)) & 1u) {
+                    v.push_back(IntVect(AMREX_D_DECL(i,j,k)));
+                }
+                ++ibit;
+            });
+            pos += nwords;
+        } else {
+            for (Long i = 0; i < n; ++i) {
+                IntVect iv;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    iv[idim] = m_data[pos++];
+                }
+                v.push_back(iv);
+            }
+        }
+    }
+}
+
+void
+TagBoxArray::collate (CompressedTags& TheGlobalCollateSpace) const
+{
+    BL_PROFILE("TagBoxArray::collate(CompressedTags)");
+
+    Vector<IntVect> tv;
+    local_collate(tv);
+
+    //
+    // The tags are in the order of the local TagBoxes.  Pack those of each
+    // TagBox as a group.
+    //
+    CompressedTags TheLocalCollateSpace;
+    const Long ntv = tv.size();
+    Long first = 0;
+    for (int li = 0; li < this->local_size() && first < ntv; ++li) {
+        Box const& bx = this->atLocalIdx(li).box();
+        Long last = first;
+        while (last < ntv && bx.contains(tv[last])) ++last;
+        TheLocalCollateSpace.pack(tv.data()+first, last-first);
+        first = last;
+    }
+    TheLocalCollateSpace.pack(tv.data()+first, ntv-first);
+    tv.clear();
+
+    Long numtags = TheLocalCollateSpace.numTags();
+    ParallelDescriptor::ReduceLongSum(numtags);
+
+    TheGlobalCollateSpace.m_data.clear();
+    TheGlobalCollateSpace.m_numtags = numtags;
+
+    if (numtags == 0) return;
+
+#ifdef BL_USE_MPI
+    Long count = TheLocalCollateSpace.m_data.size();
+    Long totalcount = count;
+    ParallelDescriptor::ReduceLongSum(totalcount);
+    if (totalcount > static_cast<Long>(std::numeric_limits<int>::max())) {
+        amrex::Abort("TagBoxArray::collate: Too many tags even after compression. Using a larger blocking factor might help.");
+    }
+    //
+    // Tell root CPU how much data each CPU will be sending.
+    //
+    const int IOProcNumber = ParallelDescriptor::IOProcessorNumber();
+    const std::vector<int>& countvec = ParallelDescriptor::Gather(static_cast<int>(count),
+                                                                  IOProcNumber);
+    std::vector<int> offset(countvec.size(),0);
+    if (ParallelDescriptor::IOProcessor()) {
+        for (int i = 1, N = offset.size(); i < N; i++) {
+            offset[i] = offset[i-1] + countvec[i-1];
+        }
+        TheGlobalCollateSpace.m_data.resize(totalcount);
+    }
+    const int* psend = (count > 0) ? TheLocalCollateSpace.m_data.data() : nullptr;
+    int* precv = TheGlobalCollateSpace.m_data.data();
+    ParallelDescriptor::Gatherv(psend, count, precv, countvec, offset, IOProcNumber);
+#else
+    TheGlobalCollateSpace = std::move(TheLocalCollateSpace);
+#endif
+}
+
 void
 TagBoxArray::setVal (const BoxList& bl, TagBox::TagVal val)
 {
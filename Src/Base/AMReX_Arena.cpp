@@ -4,6 +4,7 @@
 #include <AMReX_CArena.H>
 #include <AMReX_DArena.H>
 #include <AMReX_EArena.H>
+#include <AMReX_SArena.H>
 
 #include <AMReX.H>
 #include <AMReX_Print.H>
@@ -37,6 +38,7 @@ namespace {
     bool use_buddy_allocator = false;
     Long buddy_allocator_size = 0L;
     Long the_arena_init_size = 0L;
+    std::string the_arena_type;
 #ifdef AMREX_USE_HIP
     bool the_arena_is_managed = false; // xxxxx HIP FIX HERE
 #else
@@ -160,6 +162,7 @@ Arena::Initialize ()
     pp.query("buddy_allocator_size", buddy_allocator_size);
     pp.query("the_arena_init_size", the_arena_init_size);
     pp.query("the_arena_is_managed", the_arena_is_managed);
+    pp.query("the_arena_type", the_arena_type);
     pp.query("abort_on_out_of_gpu_memory", abort_on_out_of_gpu_memory);
 
 #ifdef AMREX_USE_GPU
@@ -184,27 +187,45 @@ Arena::Initialize ()
     else
 #endif
     {
-#if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
-        if (the_arena_is_managed) {
-            the_arena = new CArena(0, ArenaInfo().SetPreferred());
-        } else {
-            the_arena = new CArena(0, ArenaInfo().SetDeviceMemory());
+#if defined(AMREX_USE_GPU)
+        if (!the_arena_type.empty() && the_arena_type != "CArena") {
+            amrex::Warning("amrex.the_arena_type = " + the_arena_type
+                           + " is not supported for GPU builds; using CArena");
         }
+#else
+        if (the_arena_type == "SArena") {
+            the_arena = new SArena;
+        } else if (the_arena_type == "CArena") {
+            the_arena = new CArena;
+        } else if (the_arena_type == "BArena") {
+            the_arena = new BArena;
+        } else if (!the_arena_type.empty()) {
+            amrex::Abort("Unknown amrex.the_arena_type: " + the_arena_type);
+        } else
+#endif
+        {
+#if defined(BL_COALESCE_FABS) || defined(AMREX_USE_GPU)
+            if (the_arena_is_managed) {
+                the_arena = new CArena(0, ArenaInfo().SetPreferred());
+            } else {
+                the_arena = new CArena(0, ArenaInfo().SetDeviceMemory());
+            }
 #ifdef AMREX_USE_GPU
-        if (the_arena_init_size <= 0) {
+            if (the_arena_init_size <= 0) {
 #ifdef AMREX_USE_DPCPP
 //            the_arena_init_size = Gpu::Device::maxMemAllocSize() / 4L * 3L;
-            the_arena_init_size = 1024L*1024L*1024L; // xxxxx DPCPP: todo
+                the_arena_init_size = 1024L*1024L*1024L; // xxxxx DPCPP: todo
 #else
-            the_arena_init_size = Gpu::Device::totalGlobalMem() / 4L * 3L;
+                the_arena_init_size = Gpu::Device::totalGlobalMem() / 4L * 3L;
 #endif
-        }
-        void *p = the_arena->alloc(static_cast<std::size_t>(the_arena_init_size));
-        the_arena->free(p);
+            }
+            void *p = the_arena->alloc(static_cast<std::size_t>(the_arena_init_size));
+            the_arena->free(p);
 #endif
 #else
-        the_arena = new BArena;
+            the_arena = new BArena;
 #endif
+        }
     }
 
 #ifdef AMREX_USE_GPU
@@ -272,6 +293,10 @@ Arena::PrintUsage ()
         if (p) {
             p->PrintUsage("The         Arena");
         }
+        SArena* ps = dynamic_cast<SArena*>(The_Arena());
+        if (ps) {
+            ps->PrintUsage("The         Arena");
+        }
     }
     if (The_Device_Arena()) {
         CArena* p = dynamic_cast<CArena*>(The_Device_Arena());
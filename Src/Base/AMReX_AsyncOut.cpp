@@ -4,8 +4,12 @@
 #include <AMReX_Vector.H>
 #include <AMReX_ParmParse.H>
 #include <AMReX_Utility.H>
+#include <AMReX_Print.H>
 #include <AMReX.H>
 
+#include <condition_variable>
+#include <mutex>
+
 namespace amrex {
 namespace AsyncOut {
 
@@ -19,21 +23,40 @@ int s_asyncout = true; // Have this on by default for DPC++ for now so that
 int s_asyncout = false;
 #endif
 int s_noutfiles = 64;
-MPI_Comm s_comm = MPI_COMM_NULL;
+int s_nthreads = 1;
+Long s_max_bytes = 0;
+
+// One of each per worker thread
+Vector<MPI_Comm> s_comm;
+Vector<MPI_Comm> s_comm_all;
+Vector<std::unique_ptr<BackgroundThread> > s_thread;
 
-std::unique_ptr<BackgroundThread> s_thread;
+int s_next_thread = 0;
+thread_local int t_thread = 0; // worker running the current job
 
 WriteInfo s_info;
 
+std::mutex s_mutex;
+std::condition_variable s_cond;
+std::size_t s_bytes = 0;  // memory held by jobs not yet finished
+Long s_queued = 0;        // jobs submitted but not yet started
+Stats s_stats;
+
 }
 
 void Initialize ()
 {
-    amrex::ignore_unused(s_comm,s_info);
+    amrex::ignore_unused(s_info);
 
     ParmParse pp("amrex");
     pp.query("async_out", s_asyncout);
     pp.query("async_out_nfiles", s_noutfiles);
+    pp.query("async_out_nthreads", s_nthreads);
+    pp.query("async_out_max_bytes", s_max_bytes);
+    s_nthreads = std::max(s_nthreads, 1);
+
+    s_comm.assign(s_nthreads, MPI_COMM_NULL);
+    s_comm_all.assign(s_nthreads, MPI_COMM_NULL);
 
     int nprocs = ParallelDescriptor::NProcs();
     s_noutfiles = std::min(s_noutfiles, nprocs);
@@ -51,25 +74,55 @@ void Initialize ()
 
         int myproc = ParallelDescriptor::MyProc();
         s_info = GetWriteInfo(myproc);
-        MPI_Comm_split(ParallelDescriptor::Communicator(), s_info.ifile, myproc, &s_comm);
+        for (auto& comm : s_comm) {
+            MPI_Comm_split(ParallelDescriptor::Communicator(), s_info.ifile, myproc, &comm);
+        }
+    }
+
+    if (s_asyncout and nprocs > 1)
+    {
+        int provided = -1;
+        MPI_Query_thread(&provided);
+        if (provided >= MPI_THREAD_MULTIPLE) {
+            for (auto& comm : s_comm_all) {
+                MPI_Comm_dup(ParallelDescriptor::Communicator(), &comm);
+            }
+        }
     }
 #endif
 
-    if (s_asyncout) s_thread.reset(new BackgroundThread());
+    if (s_asyncout) {
+        for (int i = 0; i < s_nthreads; ++i) {
+            s_thread.emplace_back(new BackgroundThread());
+        }
+    }
 
     ExecOnFinalize(Finalize);
 }
 
 void Finalize ()
 {
-    if (s_thread) {
-        s_thread.reset();
+    if (!s_thread.empty()) {
+        s_thread.clear();
+        if (amrex::Verbose() > 1 and s_stats.njobs > 0) {
+            PrintStats();
+        }
     }
 
 #ifdef AMREX_USE_MPI
-    if (s_comm != MPI_COMM_NULL) MPI_Comm_free(&s_comm);
-    s_comm = MPI_COMM_NULL;
+    for (auto& comm : s_comm) {
+        if (comm != MPI_COMM_NULL) MPI_Comm_free(&comm);
+    }
+    for (auto& comm : s_comm_all) {
+        if (comm != MPI_COMM_NULL) MPI_Comm_free(&comm);
+    }
 #endif
+    s_comm.clear();
+    s_comm_all.clear();
+    s_next_thread = 0;
+    s_bytes = 0;
+    s_queued = 0;
+    s_stats = Stats();
 }
 
 bool UseAsyncOut () { return s_asyncout; }
@@ -97,19 +150,94 @@ WriteInfo GetWriteInfo (int rank)
     return WriteInfo{ifile, ispot, nspots};
 }
 
-void Submit (std::function<void()>&& a_f)
+namespace {
+// Called with s_mutex locked
+void reserve (std::unique_lock<std::mutex>& lck, std::size_t nbytes)
 {
-    s_thread->Submit(std::move(a_f));
+    const double t_submit = amrex::second();
+    if (s_max_bytes > 0) {
+        s_cond.wait(lck, [nbytes] () -> bool {
+            return s_bytes == 0 or s_bytes + nbytes <= static_cast<std::size_t>(s_max_bytes);
+        });
+    }
+    s_bytes += nbytes;
+    s_stats.max_bytes = std::max(s_stats.max_bytes, s_bytes);
+    s_stats.submit_wait_time += amrex::second() - t_submit;
+}
 }
 
-void Submit (std::function<void()> const& a_f)
+void Reserve (std::size_t nbytes)
 {
-    s_thread->Submit(a_f);
+    std::unique_lock<std::mutex> lck(s_mutex);
+    reserve(lck, nbytes);
+}
+
+void Submit (std::function<void()>&& a_f, std::size_t nbytes, bool reserved)
+{
+    {
+        std::unique_lock<std::mutex> lck(s_mutex);
+        if (!reserved) {
+            reserve(lck, nbytes);
+        }
+        ++s_queued;
+        ++s_stats.njobs;
+        s_stats.max_queue_depth = std::max(s_stats.max_queue_depth, s_queued);
+    }
+
+    const int ithread = s_next_thread;
+    s_next_thread = (s_next_thread + 1) % static_cast<int>(s_thread.size());
+
+    auto f = std::make_shared<std::function<void()> >(std::move(a_f));
+    const double t_queued = amrex::second();
+    s_thread[ithread]->Submit([=] ()
+    {
+        {
+            std::lock_guard<std::mutex> lck(s_mutex);
+            --s_queued;
+            const double t_wait = amrex::second() - t_queued;
+            s_stats.total_wait_time += t_wait;
+            s_stats.max_wait_time = std::max(s_stats.max_wait_time, t_wait);
+        }
+
+        t_thread = ithread;
+        (*f)();
+        *f = nullptr; // release what the job holds before accounting for it
+
+        {
+            std::lock_guard<std::mutex> lck(s_mutex);
+            s_bytes -= nbytes;
+        }
+        s_cond.notify_all();
+    });
+}
+
+void Submit (std::function<void()> const& a_f, std::size_t nbytes, bool reserved)
+{
+    Submit(std::function<void()>(a_f), nbytes, reserved);
 }
 
 void Finish ()
 {
-    s_thread->Finish();
+    for (auto& t : s_thread) {
+        t->Finish();
+    }
+}
+
+Stats GetStats ()
+{
+    std::lock_guard<std::mutex> lck(s_mutex);
+    return s_stats;
+}
+
+void PrintStats ()
+{
+    const Stats stats = GetStats();
+    amrex::Print() << "AsyncOut: " << stats.njobs << " jobs on " << s_nthreads
+                   << " threads, max queue depth " << stats.max_queue_depth
+                   << ", max memory held " << stats.max_bytes << " bytes\n"
+                   << "AsyncOut: time in queue total " << stats.total_wait_time
+                   << " max " << stats.max_wait_time
+                   << ", Submit blocked on memory budget " << stats.submit_wait_time << "\n";
 }
 
 void Wait ()
@@ -120,7 +248,7 @@ void Wait ()
         Vector<MPI_Request> reqs(N);
         Vector<MPI_Status> stats(N);
         for (int i = 0; i < N; ++i) {
-            reqs[i] = ParallelDescriptor::Abarrier(s_comm).req();
+            reqs[i] = ParallelDescriptor::Abarrier(s_comm[t_thread]).req();
         }
         ParallelDescriptor::Waitall(reqs, stats);
     }
@@ -135,11 +263,16 @@ void Notify ()
         Vector<MPI_Request> reqs(N);
         Vector<MPI_Status> stats(N);
         for (int i = 0; i < N; ++i) {
-            reqs[i] = ParallelDescriptor::Abarrier(s_comm).req();
+            reqs[i] = ParallelDescriptor::Abarrier(s_comm[t_thread]).req();
         }
         ParallelDescriptor::Waitall(reqs, stats);
     }
 #endif
 }
 
+MPI_Comm Communicator ()
+{
+    return s_comm_all.empty() ? MPI_COMM_NULL : s_comm_all[t_thread];
+}
+
 }}
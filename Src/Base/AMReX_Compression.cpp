@@ -0,0 +1,289 @@
+
+#include <AMReX_Compression.H>
+#include <AMReX.H>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#ifdef AMREX_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace amrex {
+namespace Compression {
+
+#ifdef AMREX_USE_ZLIB
+namespace {
+
+//
+// Byte i of element k goes to position i*nelems+k.  The high order bytes of
+// neighboring floating-point values tend to be equal, so this gives the
+// compressor long runs to work with.
+//
+void shuffle (const char* src, char* dst, std::size_t nelems, int elem_size)
+{
+    for (std::size_t k = 0; k < nelems; ++k) {
+        for (int i = 0; i < elem_size; ++i) {
+            dst[i*nelems+k] = src[k*elem_size+i];
+        }
+    }
+}
+
+void unshuffle (const char* src, char* dst, std::size_t nelems, int elem_size)
+{
+    for (int i = 0; i < elem_size; ++i) {
+        for (std::size_t k = 0; k < nelems; ++k) {
+            dst[k*elem_size+i] = src[i*nelems+k];
+        }
+    }
+}
+
+}
+#endif
+
+Codec DefaultCodec ()
+{
+#ifdef AMREX_USE_ZLIB
+    return Zlib;
+#else
+    return None;
+#endif
+}
+
+bool Available (Codec codec)
+{
+    switch (codec)
+    {
+    case None:
+        return true;
+    case Zlib:
+#ifdef AMREX_USE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+std::string CodecName (Codec codec)
+{
+    switch (codec)
+    {
+    case None:
+        return "none";
+    case Zlib:
+        return "zlib";
+    default:
+        amrex::Abort("Compression::CodecName: unknown codec " + std::to_string(int(codec)));
+        return std::string();
+    }
+}
+
+Codec CodecFromName (const std::string& name)
+{
+    if (name == "none") {
+        return None;
+    } else if (name == "zlib") {
+        return Zlib;
+    } else {
+        amrex::Abort("Compression::CodecFromName: unknown codec " + name);
+        return None;
+    }
+}
+
+void Compress (Codec codec, int level, const void* src, std::size_t nbytes,
+               int elem_size, Vector<char>& dst)
+{
+    const std::size_t dst_begin = dst.size();
+
+    if (codec == None)
+    {
+        dst.resize(dst_begin + nbytes);
+        std::memcpy(dst.data() + dst_begin, src, nbytes);
+        return;
+    }
+
+#ifdef AMREX_USE_ZLIB
+    if (codec == Zlib)
+    {
+        const char* p = static_cast<const char*>(src);
+        Vector<char> tmp;
+        if (elem_size > 1 && nbytes % elem_size == 0) {
+            tmp.resize(nbytes);
+            shuffle(p, tmp.data(), nbytes/elem_size, elem_size);
+            p = tmp.data();
+        }
+
+        uLongf len = compressBound(nbytes);
+        dst.resize(dst_begin + len);
+        int r = compress2(reinterpret_cast<Bytef*>(dst.data() + dst_begin), &len,
+                          reinterpret_cast<const Bytef*>(p), nbytes,
+                          std::max(Z_DEFAULT_COMPRESSION, std::min(level, Z_BEST_COMPRESSION)));
+        if (r != Z_OK) {
+            amrex::Abort("Compression::Compress: zlib compress2 failed with " + std::to_string(r));
+        }
+        dst.resize(dst_begin + len);
+        return;
+    }
+#else
+    amrex::ignore_unused(level, elem_size);
+#endif
+
+    amrex::Abort("Compression::Compress: codec " + CodecName(codec)
+                 + " is not available in this build");
+}
+
+void Decompress (Codec codec, const void* src, std::size_t nsrc,
+                 void* dst, std::size_t nbytes, int elem_size)
+{
+    if (codec == None)
+    {
+        if (nsrc != nbytes) {
+            amrex::Abort("Compression::Decompress: size mismatch");
+        }
+        std::memcpy(dst, src, nbytes);
+        return;
+    }
+
+#ifdef AMREX_USE_ZLIB
+    if (codec == Zlib)
+    {
+        const bool shuffled = elem_size > 1 && nbytes % elem_size == 0;
+        Vector<char> tmp;
+        char* p = static_cast<char*>(dst);
+        if (shuffled) {
+            tmp.resize(nbytes);
+            p = tmp.data();
+        }
+
+        uLongf len = nbytes;
+        int r = uncompress(reinterpret_cast<Bytef*>(p), &len,
+                           static_cast<const Bytef*>(src), nsrc);
+        if (r != Z_OK || len != nbytes) {
+            amrex::Abort("Compression::Decompress: zlib uncompress failed with " + std::to_string(r));
+        }
+
+        if (shuffled) {
+            unshuffle(p, static_cast<char*>(dst), nbytes/elem_size, elem_size);
+        }
+        return;
+    }
+#else
+    amrex::ignore_unused(elem_size);
+#endif
+
+    amrex::Abort("Compression::Decompress: codec " + CodecName(codec)
+                 + " is not available in this build");
+}
+
+namespace {
+
+    enum QuantizedMode : char { Lossless = 0, Quantized = 1 };
+
+    //
+    // Blocks with any quantized value beyond this fall back to lossless, so
+    // that the differences always fit in an int64_t.
+    //
+    constexpr Real max_quantized = Real(std::int64_t(1) << 52);
+
+}
+
+void CompressQuantized (Codec codec, int level, const Real* src, Long n,
+                        Real errbound, Vector<char>& dst)
+{
+    const Real step = Real(2.0)*errbound;
+
+    //
+    // Differences of neighboring quantized values, zigzag mapped to unsigned
+    // and written as variable length integers, 7 bits per byte.  Smooth data
+    // give mostly one-byte differences.
+    //
+    Vector<unsigned char> varint;
+    varint.reserve(n);
+    bool ok = step > Real(0.0);
+    std::int64_t qprev = 0;
+    for (Long i = 0; i < n && ok; ++i)
+    {
+        const Real r = src[i] / step;
+        if (!(std::abs(r) < max_quantized)) {
+            ok = false;
+            break;
+        }
+        const std::int64_t q = std::llround(r);
+        if (!(std::abs(Real(q)*step - src[i]) <= errbound)) {
+            ok = false;
+            break;
+        }
+        const std::int64_t d = q - qprev;
+        qprev = q;
+        std::uint64_t z = (static_cast<std::uint64_t>(d) << 1) ^ static_cast<std::uint64_t>(d >> 63);
+        while (z >= 0x80) {
+            varint.push_back(static_cast<unsigned char>(z | 0x80));
+            z >>= 7;
+        }
+        varint.push_back(static_cast<unsigned char>(z));
+    }
+
+    if (ok)
+    {
+        dst.push_back(Quantized);
+        const std::uint64_t nvarint = varint.size();
+        const std::size_t pos = dst.size();
+        dst.resize(pos + sizeof(nvarint));
+        std::memcpy(dst.data() + pos, &nvarint, sizeof(nvarint));
+        Compress(codec, level, varint.data(), nvarint, 1, dst);
+    }
+    else
+    {
+        dst.push_back(Lossless);
+        Compress(codec, level, src, n*sizeof(Real), sizeof(Real), dst);
+    }
+}
+
+void DecompressQuantized (Codec codec, const void* src, std::size_t nsrc,
+                          Real* dst, Long n, Real errbound)
+{
+    const char* p = static_cast<const char*>(src);
+    if (nsrc < 1) {
+        amrex::Abort("Compression::DecompressQuantized: empty block");
+    }
+
+    if (p[0] == Lossless)
+    {
+        Decompress(codec, p+1, nsrc-1, dst, n*sizeof(Real), sizeof(Real));
+        return;
+    }
+
+    std::uint64_t nvarint;
+    std::memcpy(&nvarint, p+1, sizeof(nvarint));
+    const std::size_t hdr_size = 1 + sizeof(nvarint);
+    Vector<unsigned char> varint(nvarint);
+    Decompress(codec, p+hdr_size, nsrc-hdr_size, varint.data(), nvarint, 1);
+
+    const Real step = Real(2.0)*errbound;
+    std::int64_t q = 0;
+    std::size_t k = 0;
+    for (Long i = 0; i < n; ++i)
+    {
+        std::uint64_t z = 0;
+        int shift = 0;
+        unsigned char b;
+        do {
+            if (k >= nvarint) {
+                amrex::Abort("Compression::DecompressQuantized: corrupt block");
+            }
+            b = varint[k++];
+            z |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            shift += 7;
+        } while (b & 0x80);
+        const std::int64_t d = static_cast<std::int64_t>(z >> 1) ^ -static_cast<std::int64_t>(z & 1);
+        q += d;
+        dst[i] = Real(q)*step;
+    }
+}
+
+}}
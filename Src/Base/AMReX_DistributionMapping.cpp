@@ -73,6 +73,9 @@ DistributionMapping::strategy (DistributionMapping::Strategy how)
     case RRSFC:
         m_BuildMap = &DistributionMapping::RRSFCProcessorMap;
         break;
+    case NODESFC:
+        m_BuildMap = &DistributionMapping::NodeSFCProcessorMap;
+        break;
     default:
         amrex::Error("Bad DistributionMapping::Strategy");
     }
@@ -144,6 +147,10 @@ DistributionMapping::Initialize ()
         {
             strategy(RRSFC);
         }
+        else if (theStrategy == "NODESFC")
+        {
+            strategy(NODESFC);
+        }
         else
         {
             std::string msg("Unknown strategy: ");
@@ -1435,6 +1442,381 @@ DistributionMapping::RRSFCProcessorMap (const BoxArray&          boxes,
     RRSFCDoIt(boxes,nprocs);
 }
 
+namespace {
+    //
+    // Node id of each process in ParallelContext::CommunicatorSub(), indexed by
+    // local rank.  Nodes are numbered 0 .. nnodes-1 in order of their lowest rank.
+    // If DistributionMapping.node_size is set, consecutive blocks of node_size
+    // ranks are treated as a node instead of asking MPI.
+    //
+    int
+    NodeOfRank (Vector<int>& node)
+    {
+        const int nprocs = ParallelContext::NProcsSub();
+        node.resize(nprocs);
+
+        Vector<int> leader(nprocs);
+        if (node_size > 0)
+        {
+            for (int i = 0; i < nprocs; ++i) {
+                leader[i] = (i/node_size)*node_size;
+            }
+        }
+        else
+        {
+#ifdef BL_USE_MPI
+            MPI_Comm comm = ParallelContext::CommunicatorSub();
+            const int myproc = ParallelContext::MyProcSub();
+            MPI_Comm node_comm;
+            MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, myproc, MPI_INFO_NULL, &node_comm);
+            int myleader = myproc;
+            MPI_Bcast(&myleader, 1, MPI_INT, 0, node_comm);
+            MPI_Comm_free(&node_comm);
+            MPI_Allgather(&myleader, 1, MPI_INT, leader.data(), 1, MPI_INT, comm);
+#else
+            std::fill(leader.begin(), leader.end(), 0);
+#endif
+        }
+
+        int nnodes = 0;
+        std::map<int,int> leader_to_node;
+        for (int i = 0; i < nprocs; ++i) {
+            auto it = leader_to_node.find(leader[i]);
+            if (it == leader_to_node.end()) {
+                it = leader_to_node.emplace(leader[i], nnodes++).first;
+            }
+            node[i] = it->second;
+        }
+        return nnodes;
+    }
+
+    //
+    // Box adjacency graph: graph[i] holds (j, number of cells of box j inside
+    // box i grown by ngrow) for every box j != i that touches box i.
+    //
+    using BoxGraph = Vector<Vector<std::pair<int,Long> > >;
+
+    void
+    BuildBoxGraph (const BoxArray& ba, int ngrow, BoxGraph& graph)
+    {
+        BL_PROFILE("BuildBoxGraph()");
+
+        const int N = ba.size();
+        graph.clear();
+        graph.resize(N);
+        std::vector< std::pair<int,Box> > isects;
+        for (int i = 0; i < N; ++i)
+        {
+            ba.intersections(amrex::grow(ba[i],ngrow), isects);
+            for (const auto& is : isects)
+            {
+                if (is.first != i) {
+                    graph[i].push_back(std::make_pair(is.first, is.second.numPts()));
+                }
+            }
+        }
+    }
+
+    void
+    NodeCommunicationVolume (const BoxArray& ba, const Vector<int>& pmap,
+                             const Vector<int>& node, int ngrow,
+                             Long& internode, Long& intranode)
+    {
+        internode = 0;
+        intranode = 0;
+        BoxGraph graph;
+        BuildBoxGraph(ba, ngrow, graph);
+        for (int i = 0, N = ba.size(); i < N; ++i)
+        {
+            for (const auto& e : graph[i])
+            {
+                const int j = e.first;
+                if (pmap[j] != pmap[i])
+                {
+                    if (node[pmap[j]] == node[pmap[i]]) {
+                        intranode += e.second;
+                    } else {
+                        internode += e.second;
+                    }
+                }
+            }
+        }
+    }
+
+    //
+    // Fraction of the ghost cell exchange volume that crosses process boundaries.
+    //
+    Real
+    CutRatio (const BoxGraph& graph, const Vector<int>& pmap)
+    {
+        Long cut = 0, total = 0;
+        for (int i = 0, N = graph.size(); i < N; ++i)
+        {
+            for (const auto& e : graph[i])
+            {
+                total += e.second;
+                if (pmap[e.first] != pmap[i]) cut += e.second;
+            }
+        }
+        return (total > 0) ? static_cast<Real>(cut)/static_cast<Real>(total) : Real(0.0);
+    }
+
+    //
+    // Greedy refinement of a partition.  Boxes on a partition boundary are
+    // moved to the rank of a neighbor whenever that lowers
+    //
+    //    sum_p (L_p/L_avg - 1)^2 / nprocs  +  comm_weight * cut/total
+    //
+    // where L_p is the load of rank p and cut/total is the fraction of the
+    // adjacency graph cut by the partition.  pmap holds local ranks.
+    //
+    void
+    RefineCommCut (const std::vector<Long>& wgts, const BoxGraph& graph,
+                   int nprocs, Real comm_weight, int nmax, Vector<int>& pmap)
+    {
+        BL_PROFILE("RefineCommCut()");
+
+        const int N = wgts.size();
+
+        Vector<Real> load(nprocs, 0.0);
+        Vector<int>  nboxes(nprocs, 0);
+        Real total_load = 0;
+        for (int i = 0; i < N; ++i) {
+            load[pmap[i]] += wgts[i];
+            ++nboxes[pmap[i]];
+            total_load += wgts[i];
+        }
+        Long total_edge = 0;
+        for (const auto& g : graph) {
+            for (const auto& e : g) {
+                total_edge += e.second;
+            }
+        }
+        if (total_load <= 0 || total_edge == 0) return;
+
+        const Real avg = total_load/nprocs;
+        const Real fload = Real(1.0)/(nprocs*avg*avg);
+        // Every edge is counted from both of its ends.
+        const Real fcut = Real(2.0)*comm_weight/total_edge;
+
+        std::map<int,Long> conn;
+        constexpr int max_passes = 8;
+        for (int pass = 0; pass < max_passes; ++pass)
+        {
+            int nmoves = 0;
+            for (int i = 0; i < N; ++i)
+            {
+                const int a = pmap[i];
+                conn.clear();
+                for (const auto& e : graph[i]) {
+                    conn[pmap[e.first]] += e.second;
+                }
+                const Long conn_a = (conn.count(a)) ? conn[a] : 0L;
+                const Real w = wgts[i];
+
+                Real best_dj = 0;
+                int  best_b  = -1;
+                for (const auto& c : conn)
+                {
+                    const int b = c.first;
+                    if (b == a || nboxes[b] >= nmax) continue;
+                    const Real dload = ( (load[a]-w-avg)*(load[a]-w-avg)
+                                        +(load[b]+w-avg)*(load[b]+w-avg)
+                                        -(load[a]-avg)*(load[a]-avg)
+                                        -(load[b]-avg)*(load[b]-avg) ) * fload;
+                    const Real dcut = (conn_a - c.second) * fcut;
+                    const Real dj = dload + dcut;
+                    if (dj < best_dj) {
+                        best_dj = dj;
+                        best_b = b;
+                    }
+                }
+
+                if (best_b >= 0 && nboxes[a] > 1)
+                {
+                    load[a] -= w;
+                    load[best_b] += w;
+                    --nboxes[a];
+                    ++nboxes[best_b];
+                    pmap[i] = best_b;
+                    ++nmoves;
+                }
+            }
+            if (flag_verbose_mapper) {
+                Print() << "  RefineCommCut pass " << pass << ": " << nmoves << " moves\n";
+            }
+            if (nmoves == 0) break;
+        }
+    }
+}
+
+void
+DistributionMapping::NodeSFCDoIt (const BoxArray&          boxes,
+                                  const std::vector<Long>& wgts,
+                                  Real*                    eff)
+{
+    BL_PROFILE("DistributionMapping::NodeSFCDoIt()");
+
+#if defined (BL_USE_TEAM)
+    amrex::Abort("Team support is not implemented yet in NODESFC");
+#endif
+
+    const int nprocs = ParallelContext::NProcsSub();
+
+    Vector<int> node;
+    const int nnodes = NodeOfRank(node);
+
+    // Local ranks belonging to each node.
+    Vector<Vector<int> > node_ranks(nnodes);
+    for (int i = 0; i < nprocs; ++i) {
+        node_ranks[node[i]].push_back(i);
+    }
+
+    if (flag_verbose_mapper) {
+        Print() << "DM: NodeSFCDoIt called with (nprocs, nnodes) = ("
+                << nprocs << ", " << nnodes << ")\n";
+    }
+
+    const int N = boxes.size();
+    std::vector<SFCToken> tokens;
+    tokens.reserve(N);
+    for (int i = 0; i < N; ++i)
+    {
+        const Box& bx = boxes[i];
+        tokens.push_back(makeSFCToken(i, bx.smallEnd()));
+    }
+    //
+    // Put'm in Morton space filling curve order.
+    //
+    std::sort(tokens.begin(), tokens.end(), SFCToken::Compare());
+
+    Real totalvol = 0;
+    for (Long wt : wgts) {
+        totalvol += wt;
+    }
+    //
+    // First cut the curve into contiguous pieces, one per node, with each
+    // piece proportional to the number of ranks on the node.  A token goes to
+    // the current node as long as its midpoint is within the node's share.
+    //
+    Vector<std::vector<SFCToken> > node_tokens(nnodes);
+    {
+        int  inode   = 0;
+        Real accum   = 0;
+        Real target  = totalvol * node_ranks[0].size() / nprocs;
+        int  nranks  = node_ranks[0].size();
+        for (const auto& t : tokens)
+        {
+            const Real w = wgts[t.m_box];
+            while (inode < nnodes-1 && !node_tokens[inode].empty()
+                   && accum + Real(0.5)*w > target)
+            {
+                ++inode;
+                nranks += node_ranks[inode].size();
+                target = totalvol * nranks / nprocs;
+            }
+            node_tokens[inode].push_back(t);
+            accum += w;
+        }
+    }
+
+    tokens.clear();
+    //
+    // Then split each node's piece across its ranks.
+    //
+    Long max_wgt = 0;
+    for (int inode = 0; inode < nnodes; ++inode)
+    {
+        const auto& ranks = node_ranks[inode];
+        const int nr = ranks.size();
+
+        Real volpercpu = 0;
+        for (const auto& t : node_tokens[inode]) {
+            volpercpu += wgts[t.m_box];
+        }
+        volpercpu /= nr;
+
+        std::vector< std::vector<int> > vec(nr);
+        Distribute(node_tokens[inode],wgts,nr,volpercpu,vec);
+
+        for (int r = 0; r < nr; ++r)
+        {
+            const int grank = ParallelContext::local_to_global_rank(ranks[r]);
+            Long wgt = 0;
+            for (int ibox : vec[r]) {
+                m_ref->m_pmap[ibox] = grank;
+                wgt += wgts[ibox];
+            }
+            max_wgt = std::max(max_wgt, wgt);
+        }
+    }
+
+    if (eff || verbose)
+    {
+        Real efficiency = (max_wgt > 0) ? totalvol/(nprocs*max_wgt) : Real(1.0);
+        if (eff) *eff = efficiency;
+
+        if (verbose)
+        {
+            Vector<int> lpmap(N);
+            ParallelContext::global_to_local_rank(lpmap.data(), m_ref->m_pmap.data(), N);
+            Long internode, intranode;
+            NodeCommunicationVolume(boxes, lpmap, node, 1, internode, intranode);
+            amrex::Print() << "NODESFC efficiency: " << efficiency
+                           << ", nnodes: " << nnodes
+                           << ", inter-node ghost cells: " << internode
+                           << ", intra-node ghost cells: " << intranode << '\n';
+        }
+    }
+}
+
+void
+DistributionMapping::NodeSFCProcessorMap (const BoxArray& boxes,
+                                          int             nprocs)
+{
+    BL_ASSERT(boxes.size() > 0);
+
+    m_ref->clear();
+    m_ref->m_pmap.resize(boxes.size());
+
+    if (boxes.size() < sfc_threshold*nprocs)
+    {
+        KnapSackProcessorMap(boxes,nprocs);
+    }
+    else
+    {
+        std::vector<Long> wgts;
+
+        wgts.reserve(boxes.size());
+
+        for (int i = 0, N = boxes.size(); i < N; ++i)
+        {
+            wgts.push_back(boxes[i].volume());
+        }
+
+        NodeSFCDoIt(boxes,wgts);
+    }
+}
+
+void
+DistributionMapping::ComputeNodeCommunicationVolume (const BoxArray& ba,
+                                                     const DistributionMapping& dm,
+                                                     int ngrow, Long& internode, Long& intranode)
+{
+    BL_PROFILE("DistributionMapping::ComputeNodeCommunicationVolume()");
+
+    AMREX_ASSERT(ba.size() == dm.size());
+
+    Vector<int> node;
+    NodeOfRank(node);
+
+    const int N = dm.size();
+    Vector<int> lpmap(N);
+    ParallelContext::global_to_local_rank(lpmap.data(), dm.ProcessorMap().data(), N);
+
+    NodeCommunicationVolume(ba, lpmap, node, ngrow, internode, intranode);
+}
+
 DistributionMapping
 DistributionMapping::makeKnapSack (const Vector<Real>& rcost, int nmax)
 {
@@ -1482,6 +1864,71 @@ DistributionMapping::makeKnapSack (const Vector<Real>& rcost, Real& eff, int nma
     return r;
 }
 
+DistributionMapping
+DistributionMapping::makeKnapSack (const Vector<Real>& rcost, const BoxArray& ba,
+                                   Real& eff, Real& cut_ratio, Real comm_weight,
+                                   int ngrow, int nmax)
+{
+    BL_PROFILE("makeKnapSack");
+
+    AMREX_ASSERT(rcost.size() == ba.size());
+
+    DistributionMapping r;
+
+    std::vector<Long> cost(rcost.size());
+
+    Real wmax = *std::max_element(rcost.begin(), rcost.end());
+    Real scale = (wmax == 0) ? 1.e9 : 1.e9/wmax;
+
+    for (int i = 0; i < rcost.size(); ++i) {
+        cost[i] = Long(rcost[i]*scale) + 1L;
+    }
+
+    int nprocs = ParallelContext::NProcsSub();
+
+    r.KnapSackProcessorMap(cost, nprocs, &eff, true, nmax);
+
+    BoxGraph graph;
+    BuildBoxGraph(ba, ngrow, graph);
+
+    const int N = ba.size();
+    Vector<int> pmap(N);
+    ParallelContext::global_to_local_rank(pmap.data(), r.ProcessorMap().data(), N);
+
+    const Real knapsack_eff = eff;
+    const Real knapsack_cut = CutRatio(graph, pmap);
+
+    if (nprocs > 1 && comm_weight > 0) {
+        RefineCommCut(cost, graph, nprocs, comm_weight, nmax, pmap);
+    }
+
+    Long max_wgt = 0, sum_wgt = 0;
+    Vector<Long> load(nprocs, 0);
+    for (int i = 0; i < N; ++i) {
+        load[pmap[i]] += cost[i];
+    }
+    for (Long w : load) {
+        max_wgt = std::max(max_wgt, w);
+        sum_wgt += w;
+    }
+    eff = static_cast<Real>(sum_wgt)/(nprocs*max_wgt);
+    cut_ratio = CutRatio(graph, pmap);
+
+    Vector<int> gpmap(N);
+    ParallelContext::local_to_global_rank(gpmap.data(), pmap.data(), N);
+    r = DistributionMapping(std::move(gpmap));
+
+    if (verbose)
+    {
+        amrex::Print() << "KNAPSACK+COMM efficiency: " << eff
+                       << ", cut ratio: " << cut_ratio
+                       << " (knapsack only: " << knapsack_eff
+                       << ", " << knapsack_cut << ")\n";
+    }
+
+    return r;
+}
+
 DistributionMapping
 DistributionMapping::makeKnapSack (const LayoutData<Real>& rcost_local,
                                    Real& currentEfficiency, Real& proposedEfficiency,
@@ -1595,6 +2042,21 @@ DistributionMapping::ComputeDistributionMappingEfficiency (const DistributionMap
                                    rankToCost.end(), 0.0) / (nprocs*maxCost));
 }
 
+void
+DistributionMapping::ComputeDistributionMappingCutRatio (const DistributionMapping& dm,
+                                                         const BoxArray& ba,
+                                                         Real* cut_ratio, int ngrow)
+{
+    AMREX_ASSERT(ba.size() == dm.size());
+
+    BoxGraph graph;
+    BuildBoxGraph(ba, ngrow, graph);
+
+    // Write `cut_ratio` (number between 0 and 1), the fraction of ghost cells
+    // that have to be communicated between processes
+    *cut_ratio = CutRatio(graph, dm.ProcessorMap());
+}
+
 namespace {
 Vector<Long>
 gather_weights (const MultiFab& weight)
@@ -25,6 +25,8 @@ namespace amrex {
 // Set default values in Initialize()!!!
 //
 int     FabArrayBase::MaxComp;
+bool    FabArrayBase::persistent_fb;
+bool    FabArrayBase::fp_scratch_cache;
 
 #if defined(AMREX_USE_GPU)
 
@@ -94,6 +96,8 @@ FabArrayBase::Initialize ()
     // Set default values here!!!
     //
     FabArrayBase::MaxComp           = 25;
+    FabArrayBase::persistent_fb     = false;
+    FabArrayBase::fp_scratch_cache  = true;
 
     ParmParse pp("fabarray");
 
@@ -115,6 +119,8 @@ FabArrayBase::Initialize ()
     }
 
     pp.query("maxcomp",             FabArrayBase::MaxComp);
+    pp.query("persistent_fb",       FabArrayBase::persistent_fb);
+    pp.query("fp_scratch_cache",    FabArrayBase::fp_scratch_cache);
 
     if (MaxComp < 1) {
         MaxComp = 1;
@@ -274,9 +280,111 @@ FabArrayBase::FB::bytes () const
     if (m_RcvTags)
 	cnt += FabArrayBase::bytesOfMapOfCopyComTagContainers(*m_RcvTags);
 
+    for (auto const& kv : m_plans) {
+        cnt += kv.second->bytes();
+    }
+
     return cnt;
 }
 
+Long
+FabArrayBase::FBPlan::bytes () const
+{
+    Long cnt = sizeof(FabArrayBase::FBPlan)
+        + (amrex::bytesOf(m_send_data) - sizeof(m_send_data))
+        + (amrex::bytesOf(m_send_size) - sizeof(m_send_size))
+        + (amrex::bytesOf(m_send_rank) - sizeof(m_send_rank))
+        + (amrex::bytesOf(m_send_reqs) - sizeof(m_send_reqs))
+        + (amrex::bytesOf(m_send_cctc) - sizeof(m_send_cctc))
+        + (amrex::bytesOf(m_recv_data) - sizeof(m_recv_data))
+        + (amrex::bytesOf(m_recv_size) - sizeof(m_recv_size))
+        + (amrex::bytesOf(m_recv_from) - sizeof(m_recv_from))
+        + (amrex::bytesOf(m_recv_reqs) - sizeof(m_recv_reqs));
+    for (auto n : m_send_size) { cnt += n; }
+    for (auto n : m_recv_size) { cnt += n; }
+    return cnt;
+}
+
+#ifdef BL_USE_MPI
+namespace {
+    void persistent_init (bool is_send, char* buf, std::size_t n, int rank, int tag,
+                          MPI_Comm comm, MPI_Request* req)
+    {
+        // Must be consistent with ParallelDescriptor::Asend & Arecv
+        MPI_Datatype dt;
+        std::size_t count;
+        const int comm_data_type = ParallelDescriptor::select_comm_data_type(n);
+        if (comm_data_type == 1) {
+            dt = ParallelDescriptor::Mpi_typemap<char>::type();
+            count = n;
+        } else if (comm_data_type == 2) {
+            dt = ParallelDescriptor::Mpi_typemap<unsigned long long>::type();
+            count = n/sizeof(unsigned long long);
+        } else if (comm_data_type == 3) {
+            dt = ParallelDescriptor::Mpi_typemap<ParallelDescriptor::lull_t>::type();
+            count = n/sizeof(ParallelDescriptor::lull_t);
+        } else {
+            amrex::Abort("TODO: message size is too big");
+            return;
+        }
+        if (is_send) {
+            BL_MPI_REQUIRE( MPI_Send_init(buf, count, dt, rank, tag, comm, req) );
+        } else {
+            BL_MPI_REQUIRE( MPI_Recv_init(buf, count, dt, rank, tag, comm, req) );
+        }
+    }
+}
+#endif
+
+void
+FabArrayBase::FBPlan::initRequests ()
+{
+#ifdef BL_USE_MPI
+    for (int i = 0, N = m_recv_size.size(); i < N; ++i) {
+        if (m_recv_size[i] > 0) {
+            const int rank = ParallelContext::global_to_local_rank(m_recv_from[i]);
+            persistent_init(false, m_recv_data[i], m_recv_size[i], rank, m_tag, m_comm,
+                            &m_recv_reqs[i]);
+        }
+    }
+    for (int i = 0, N = m_send_size.size(); i < N; ++i) {
+        if (m_send_size[i] > 0) {
+            const int rank = ParallelContext::global_to_local_rank(m_send_rank[i]);
+            persistent_init(true, m_send_data[i], m_send_size[i], rank, m_tag, m_comm,
+                            &m_send_reqs[i]);
+        }
+    }
+#endif
+}
+
+void
+FabArrayBase::FBPlan::start ()
+{
+#ifdef BL_USE_MPI
+    for (auto& req : m_recv_reqs) {
+        if (req != MPI_REQUEST_NULL) { BL_MPI_REQUIRE( MPI_Start(&req) ); }
+    }
+    for (auto& req : m_send_reqs) {
+        if (req != MPI_REQUEST_NULL) { BL_MPI_REQUIRE( MPI_Start(&req) ); }
+    }
+#endif
+    m_busy = true;
+}
+
+FabArrayBase::FBPlan::~FBPlan ()
+{
+#ifdef BL_USE_MPI
+    for (auto& req : m_recv_reqs) {
+        if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+    }
+    for (auto& req : m_send_reqs) {
+        if (req != MPI_REQUEST_NULL) { MPI_Request_free(&req); }
+    }
+#endif
+    if (m_the_send_data) { The_FA_Arena()->free(m_the_send_data); }
+    if (m_the_recv_data) { The_FA_Arena()->free(m_the_recv_data); }
+}
+
 Long
 FabArrayBase::TileArray::bytes () const
 {
@@ -2069,6 +2177,11 @@ FabArrayBase::flushCFinfo (bool no_assertion)
 void
 FabArrayBase::Finalize ()
 {
+    // The scratch FabArrays must go before the arenas.
+    for (auto& kv : m_TheFillPatchCache) {
+        kv.second->m_scratch.clear();
+    }
+
     FabArrayBase::flushFBCache();
     FabArrayBase::flushCPCache();
     FabArrayBase::flushRB90Cache();
@@ -146,8 +146,11 @@ MFIter::MFIter (const BoxArray& ba, const DistributionMapping& dm, const MFItInf
     tile_size(info.tilesize),
     flags(info.do_tiling ? Tiling : 0),
     streams(info.num_streams),
-    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    dynamic(info.dynamic && !info.interior_first && (OpenMP::get_num_threads() > 1)),
     device_sync(info.device_sync),
+    interior_first(info.interior_first),
+    interior_halo(info.interior_halo),
+    halo_ready(info.halo_ready),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
@@ -178,8 +181,11 @@ MFIter::MFIter (const FabArrayBase& fabarray_, const MFItInfo& info)
     tile_size(info.tilesize),
     flags(info.do_tiling ? Tiling : 0),
     streams(info.num_streams),
-    dynamic(info.dynamic && (OpenMP::get_num_threads() > 1)),
+    dynamic(info.dynamic && !info.interior_first && (OpenMP::get_num_threads() > 1)),
     device_sync(info.device_sync),
+    interior_first(info.interior_first),
+    interior_halo(info.interior_halo),
+    halo_ready(info.halo_ready),
     index_map(nullptr),
     local_index_map(nullptr),
     tile_array(nullptr),
@@ -318,7 +324,7 @@ MFIter::Initialize ()
 	
 #ifdef _OPENMP
 	int nthreads = omp_get_num_threads();
-	if (nthreads > 1)
+	if (nthreads > 1 && !interior_first)
 	{
             if (dynamic)
             {
@@ -343,6 +349,10 @@ MFIter::Initialize ()
 
 	currentIndex = beginIndex;
 
+        if (interior_first) {
+            InitializeInteriorFirst();
+        }
+
 #ifdef AMREX_USE_GPU
 	Gpu::Device::setStreamIndex((streams > 0) ? currentIndex%streams : -1);
         Gpu::resetNumCallbacks();
@@ -357,6 +367,81 @@ MFIter::Initialize ()
     }
 }
 
+void
+MFIter::InitializeInteriorFirst ()
+{
+    // Split this worker's tiles into those that do not read ghost cells
+    // and those that do.  Each thread gets its share of both kinds.
+    Vector<int> interior, boundary;
+    const BoxArray& ba = fabArray.boxArray();
+    for (int i = beginIndex; i < endIndex; ++i) {
+        const Box& vbx = ba.getCellCenteredBox((*index_map)[i]);
+        if (vbx.contains(amrex::grow((*tile_array)[i], interior_halo))) {
+            interior.push_back(i);
+        } else {
+            boundary.push_back(i);
+        }
+    }
+
+    const int tid = OpenMP::get_thread_num();
+    const int nthreads = OpenMP::get_num_threads();
+
+    m_lta.reset(new FabArrayBase::TileArray);
+    auto add_my_share = [&] (Vector<int> const& tiles)
+    {
+        int ntot = tiles.size();
+        int nr   = ntot / nthreads;
+        int nlft = ntot - nr * nthreads;
+        int ib, ie;
+        if (tid < nlft) {
+            ib = tid * (nr + 1);
+            ie = ib + nr + 1;
+        } else {
+            ib = tid * nr + nlft;
+            ie = ib + nr;
+        }
+        for (int it = ib; it < ie; ++it) {
+            const int i = tiles[it];
+            m_lta->indexMap.push_back((*index_map)[i]);
+            m_lta->localIndexMap.push_back((*local_index_map)[i]);
+            m_lta->tileArray.push_back((*tile_array)[i]);
+            m_lta->localTileIndexMap.push_back((*local_tile_index_map)[i]);
+            m_lta->numLocalTiles.push_back((*num_local_tiles)[i]);
+        }
+    };
+    add_my_share(interior);
+    halo_index = m_lta->indexMap.size();
+    add_my_share(boundary);
+
+    m_lta->nuse = 0;
+    index_map            = &(m_lta->indexMap);
+    local_index_map      = &(m_lta->localIndexMap);
+    tile_array           = &(m_lta->tileArray);
+    local_tile_index_map = &(m_lta->localTileIndexMap);
+    num_local_tiles      = &(m_lta->numLocalTiles);
+
+    currentIndex = beginIndex = 0;
+    endIndex = m_lta->indexMap.size();
+
+    if (halo_index == 0) {
+        WaitForHalo();
+    }
+}
+
+void
+MFIter::WaitForHalo ()
+{
+#ifdef _OPENMP
+#pragma omp master
+#endif
+    {
+        if (halo_ready) halo_ready();
+    }
+#ifdef _OPENMP
+#pragma omp barrier
+#endif
+}
+
 Box 
 MFIter::tilebox () const noexcept
 { 
@@ -520,6 +605,10 @@ MFIter::operator++ () noexcept
 
         ++currentIndex;
 
+        if (currentIndex == halo_index) {
+            WaitForHalo();
+        }
+
 #ifdef AMREX_USE_GPU
         if (Gpu::inLaunchRegion()) {
             Gpu::Device::setStreamIndex((streams > 0) ? currentIndex%streams : -1);
@@ -1,7 +1,18 @@
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
 #include <AMReX_PlotFileDataImpl.H>
 #include <AMReX_ParallelDescriptor.H>
 #include <AMReX_VisMF.H>
+#include <AMReX_FPC.H>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace amrex {
 
@@ -96,7 +107,113 @@ PlotFileDataImpl::PlotFileDataImpl (std::string const& plotfile_name)
     }
 }
 
-PlotFileDataImpl::~PlotFileDataImpl () {}
+PlotFileDataImpl::~PlotFileDataImpl ()
+{
+#ifndef _WIN32
+    for (auto const& kv : m_mapped_files) {
+        if (kv.second.m_p) {
+            munmap(const_cast<char*>(kv.second.m_p), kv.second.m_size);
+        }
+    }
+#endif
+}
+
+bool
+PlotFileDataImpl::mappable (int level) const noexcept
+{
+#ifdef _WIN32
+    amrex::ignore_unused(level);
+    return false;
+#else
+    if (m_vismf[level] == nullptr) return false;
+    const VisMF::Header& hdr = m_vismf[level]->header();
+    if (hdr.m_vers == VisMF::Header::Version_v1) {
+        return true;   // ---- decided FAB by FAB from the FAB headers
+    } else if (VisMF::NoFabHeader(hdr)) {
+        return hdr.m_writtenRD == FPC::NativeRealDescriptor();
+    } else {
+        return false;
+    }
+#endif
+}
+
+PlotFileDataImpl::MappedFile const&
+PlotFileDataImpl::mapFile (std::string const& file_name) noexcept
+{
+    auto it = m_mapped_files.find(file_name);
+    if (it != m_mapped_files.end()) return it->second;
+
+    MappedFile& mf = m_mapped_files[file_name];
+#ifndef _WIN32
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                mf.m_p = static_cast<char const*>(p);
+                mf.m_size = st.st_size;
+            }
+        }
+        close(fd);
+    }
+#endif
+    return mf;
+}
+
+char const*
+PlotFileDataImpl::mappedData (int level, int gid) noexcept
+{
+    if (!mappable(level)) return nullptr;
+
+    auto key = std::make_pair(level, gid);
+    auto it = m_mapped_data.find(key);
+    if (it != m_mapped_data.end()) return it->second;
+
+    char const* r = nullptr;
+
+    const VisMF::Header& hdr = m_vismf[level]->header();
+    const std::string& mf_name = m_mf_name[level];
+    std::string file_name = mf_name.substr(0, mf_name.rfind('/')+1) + hdr.m_fod[gid].m_name;
+    MappedFile const& f = mapFile(file_name);
+
+    if (f.m_p)
+    {
+        const Box bx = amrex::grow(m_ba[level][gid], m_ngrow[level]);
+        std::size_t offset = hdr.m_fod[gid].m_head;
+        bool native = true;
+        if (hdr.m_vers == VisMF::Header::Version_v1) {
+            // ---- the FAB is native if its header is what we would write
+            std::stringstream hss;
+            std::unique_ptr<FABio> fio(new FABio_binary(FPC::NativeRealDescriptor().clone()));
+            FArrayBox tmp(bx, m_ncomp, false);
+            fio->write_header(hss, tmp, m_ncomp);
+            const std::string fab_header = hss.str();
+            native = offset + fab_header.size() <= f.m_size
+                and std::memcmp(f.m_p + offset, fab_header.data(), fab_header.size()) == 0;
+            offset += fab_header.size();
+        }
+        if (native and offset + bx.numPts()*m_ncomp*sizeof(Real) <= f.m_size) {
+            r = f.m_p + offset;
+        }
+    }
+
+    m_mapped_data[key] = r;
+    return r;
+}
+
+Array4<Real const>
+PlotFileDataImpl::const_array (int level, int gid) noexcept
+{
+    char const* p = mappedData(level, gid);
+    const Box bx = amrex::grow(m_ba[level][gid], m_ngrow[level]);
+    if (p and reinterpret_cast<std::uintptr_t>(p) % alignof(Real) == 0) {
+        return Array4<Real const>(reinterpret_cast<Real const*>(p),
+                                  amrex::begin(bx), amrex::end(bx), m_ncomp);
+    } else {
+        return Array4<Real const>();
+    }
+}
 
 void
 PlotFileDataImpl::syncDistributionMap (PlotFileDataImpl const& src) noexcept
@@ -119,7 +236,20 @@ MultiFab
 PlotFileDataImpl::get (int level) noexcept
 {
     MultiFab mf(m_ba[level], m_dmap[level], m_ncomp, m_ngrow[level]);
-    VisMF::Read(mf, m_mf_name[level]);
+    if (mappable(level)) {
+        for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            int gid = mfi.index();
+            FArrayBox& dstfab = mf[mfi];
+            if (char const* p = mappedData(level, gid)) {
+                std::memcpy(dstfab.dataPtr(), p, dstfab.nBytes());
+            } else {
+                std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, m_mf_name[level]));
+                dstfab.copy<RunOn::Host>(*srcfab);
+            }
+        }
+    } else {
+        VisMF::Read(mf, m_mf_name[level]);
+    }
     return mf;
 }
 
@@ -135,8 +265,12 @@ PlotFileDataImpl::get (int level, std::string const& varname) noexcept
         for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
             int gid = mfi.index();
             FArrayBox& dstfab = mf[mfi];
-            std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
-            dstfab.copy<RunOn::Host>(*srcfab);
+            if (char const* p = mappedData(level, gid)) {
+                std::memcpy(dstfab.dataPtr(), p + icomp*dstfab.nBytes(), dstfab.nBytes());
+            } else {
+                std::unique_ptr<FArrayBox> srcfab(m_vismf[level]->readFAB(gid, icomp));
+                dstfab.copy<RunOn::Host>(*srcfab);
+            }
         }
     }
     return mf;
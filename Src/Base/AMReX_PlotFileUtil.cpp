@@ -1,12 +1,14 @@
 
 #include <fstream>
 #include <iomanip>
+#include <limits>
 
 #include <AMReX_VisMF.H>
 #include <AMReX_AsyncOut.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_FPC.H>
 #include <AMReX_FabArrayUtility.H>
+#include <AMReX_ParmParse.H>
 
 #ifdef AMREX_USE_EB
 #include <AMReX_EBFabFactory.H>
@@ -23,6 +25,49 @@
 
 namespace amrex {
 
+namespace {
+    //
+    // The error bounds of the lossy compression of each variable of mf from
+    // plotfile.lossy_atol and plotfile.lossy_rtol, or the per-variable
+    // plotfile.lossy_atol.<varname> and plotfile.lossy_rtol.<varname>.  The
+    // relative tolerance is relative to the range of the variable on the
+    // level.  If both are given the tighter one is used.  Empty if all
+    // variables are to be written losslessly.
+    //
+    Vector<Real> PlotfileErrorBounds (const MultiFab& mf, const Vector<std::string>& varnames)
+    {
+        ParmParse pp("plotfile");
+        Real atol_all(0.0), rtol_all(0.0);
+        pp.query("lossy_atol", atol_all);
+        pp.query("lossy_rtol", rtol_all);
+
+        const int ncomp(mf.nComp());
+        Vector<Real> atol(ncomp, atol_all), rtol(ncomp, rtol_all);
+        bool lossy(false);
+        for (int n = 0; n < ncomp; ++n) {
+            pp.query(("lossy_atol." + varnames[n]).c_str(), atol[n]);
+            pp.query(("lossy_rtol." + varnames[n]).c_str(), rtol[n]);
+            lossy = lossy || atol[n] > 0.0 || rtol[n] > 0.0;
+        }
+
+        Vector<Real> errbound;
+        if (lossy) {
+            errbound.resize(ncomp, 0.0);
+            for (int n = 0; n < ncomp; ++n) {
+                Real eb(atol[n] > 0.0 ? atol[n] : std::numeric_limits<Real>::max());
+                if (rtol[n] > 0.0) {
+                    const Real range(mf.max(n) - mf.min(n));
+                    if (range > 0.0) {
+                        eb = std::min(eb, rtol[n] * range);
+                    }
+                }
+                errbound[n] = (eb < std::numeric_limits<Real>::max()) ? eb : 0.0;
+            }
+        }
+        return errbound;
+    }
+}
+
 std::string LevelPath (int level, const std::string &levelPrefix)
 {
     return Concatenate(levelPrefix, level, 1);  // e.g., Level_5
@@ -225,10 +270,11 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
 
     for (int level = 0; level <= finest_level; ++level)
     {
+        const Vector<Real> errbound = PlotfileErrorBounds(*mf[level], varnames);
         if (AsyncOut::UseAsyncOut()) {
             VisMF::AsyncWrite(*mf[level],
                               MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix),
-                              true);
+                              true, errbound);
         } else {
             const MultiFab* data;
             std::unique_ptr<MultiFab> mf_tmp;
@@ -242,7 +288,8 @@ WriteMultiLevelPlotfile (const std::string& plotfilename, int nlevels,
             } else {
                 data = mf[level];
             }
-            VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix));
+            VisMF::Write(*data, MultiFabFileFullPrefix(level, plotfilename, levelPrefix, mfPrefix),
+                         VisMF::NFiles, false, errbound);
         }
     }
 }
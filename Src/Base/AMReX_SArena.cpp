@@ -0,0 +1,290 @@
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <AMReX_SArena.H>
+#include <AMReX_BLassert.H>
+#include <AMReX_Print.H>
+#include <AMReX_ParallelReduce.H>
+
+namespace amrex {
+
+namespace {
+    std::atomic<std::size_t> sarena_next_id{0};
+
+    //
+    // Live SArenas by id, so that a thread exiting can hand its heaps back.
+    //
+    std::mutex& sarena_registry_mutex ()
+    {
+        static std::mutex m;
+        return m;
+    }
+
+    std::map<std::size_t,SArena*>& sarena_registry ()
+    {
+        static std::map<std::size_t,SArena*> r;
+        return r;
+    }
+
+    struct ThreadHeaps
+    {
+        //! (arena id, heap) pairs for the arenas this thread has used.
+        std::vector<std::pair<std::size_t,void*> > m_heaps;
+
+        ~ThreadHeaps ()
+        {
+            std::lock_guard<std::mutex> lock(sarena_registry_mutex());
+            auto& registry = sarena_registry();
+            for (auto const& p : m_heaps) {
+                auto it = registry.find(p.first);
+                if (it != registry.end()) {
+                    it->second->releaseHeap(p.second);
+                }
+            }
+        }
+    };
+
+    thread_local ThreadHeaps sarena_thread_heaps;
+}
+
+SArena::SArena (std::size_t slab_size, ArenaInfo info)
+{
+    arena_info = info;
+
+    m_slab = Arena::align(slab_size == 0 ? DefaultSlabSize : slab_size);
+    m_id = sarena_next_id++;
+
+    //
+    // Size classes: multiples of align_size up to 128 bytes, then four
+    // classes per power of two up to a quarter of the slab size.
+    //
+    const std::size_t max_small = std::max(m_slab/4, std::size_t(128));
+    for (std::size_t sz = Arena::align_size; sz <= 128; sz += Arena::align_size) {
+        m_class_size.push_back(sz);
+    }
+    for (std::size_t base = 128; base < max_small; base *= 2) {
+        const std::size_t step = Arena::align(base/4);
+        for (std::size_t sz = base+step; sz <= 2*base && sz <= max_small; sz += step) {
+            m_class_size.push_back(sz);
+        }
+    }
+
+    m_large.reset(new CArena(0, info));
+
+    BL_ASSERT(sizeof(Header)%Arena::align_size == 0);
+
+    std::lock_guard<std::mutex> lock(sarena_registry_mutex());
+    sarena_registry()[m_id] = this;
+}
+
+SArena::~SArena ()
+{
+    {
+        std::lock_guard<std::mutex> lock(sarena_registry_mutex());
+        sarena_registry().erase(m_id);
+    }
+
+    for (auto const& heap : m_heaps) {
+        for (void* slab : heap->m_slabs) {
+            deallocate_system(slab, m_slab);
+        }
+    }
+}
+
+int
+SArena::sizeClass (std::size_t nbytes) const noexcept
+{
+    auto it = std::lower_bound(m_class_size.begin(), m_class_size.end(), nbytes);
+    return static_cast<int>(it - m_class_size.begin());
+}
+
+SArena::Heap*
+SArena::threadHeap ()
+{
+    for (auto const& p : sarena_thread_heaps.m_heaps) {
+        if (p.first == m_id) return static_cast<Heap*>(p.second);
+    }
+
+    //
+    // Adopt the heap of a thread that has exited if there is one.
+    //
+    Heap* heap;
+    {
+        std::lock_guard<std::mutex> lock(sarena_mutex);
+        if (m_orphans.empty()) {
+            m_heaps.emplace_back(new Heap(m_class_size.size()));
+            heap = m_heaps.back().get();
+        } else {
+            heap = m_orphans.back();
+            m_orphans.pop_back();
+        }
+    }
+    sarena_thread_heaps.m_heaps.push_back(std::make_pair(m_id, static_cast<void*>(heap)));
+    return heap;
+}
+
+void
+SArena::releaseHeap (void* heap)
+{
+    std::lock_guard<std::mutex> lock(sarena_mutex);
+    m_orphans.push_back(static_cast<Heap*>(heap));
+}
+
+void*
+SArena::alloc (std::size_t nbytes)
+{
+    nbytes = Arena::align(nbytes == 0 ? 1 : nbytes);
+
+    if (nbytes > maxSmallSize())
+    {
+        Header* h = static_cast<Header*>(m_large->alloc(sizeof(Header) + nbytes));
+        h->m_owner = nullptr;
+        h->m_cls = nbytes;
+        return h+1;
+    }
+    else
+    {
+        return allocSmall(threadHeap(), sizeClass(nbytes));
+    }
+}
+
+void*
+SArena::allocSmall (Heap* heap, int cls)
+{
+    SizeClass& sc = heap->m_class[cls];
+    const std::size_t nbytes = m_class_size[cls];
+
+    heap->m_actually_used.fetch_add(nbytes, std::memory_order_relaxed);
+
+    if (sc.m_free == nullptr) {
+        sc.m_free = sc.m_remote.exchange(nullptr, std::memory_order_acquire);
+    }
+
+    Header* h;
+    if (sc.m_free != nullptr)
+    {
+        //
+        // Free blocks keep their header; the link to the next free block
+        // lives in the first word after it.
+        //
+        h = static_cast<Header*>(sc.m_free);
+        sc.m_free = *reinterpret_cast<void**>(h+1);
+        return h+1;
+    }
+
+    const std::size_t stride = sizeof(Header) + nbytes;
+    if (sc.m_bump == nullptr || sc.m_bump + stride > sc.m_bump_end)
+    {
+        char* slab = static_cast<char*>(allocate_system(m_slab));
+        heap->m_slabs.push_back(slab);
+        m_used.fetch_add(m_slab, std::memory_order_relaxed);
+        sc.m_bump = slab;
+        sc.m_bump_end = slab + m_slab;
+    }
+
+    h = reinterpret_cast<Header*>(sc.m_bump);
+    sc.m_bump += stride;
+    h->m_owner = heap;
+    h->m_cls = cls;
+    return h+1;
+}
+
+void
+SArena::free (void* vp)
+{
+    if (vp == nullptr)
+        //
+        // Allow calls with NULL as allowed by C++ delete.
+        //
+        return;
+
+    Header* h = static_cast<Header*>(vp) - 1;
+    Heap* owner = h->m_owner;
+
+    if (owner == nullptr)
+    {
+        m_large->free(h);
+        return;
+    }
+
+    SizeClass& sc = owner->m_class[h->m_cls];
+    owner->m_actually_used.fetch_sub(m_class_size[h->m_cls], std::memory_order_relaxed);
+
+    bool mine = false;
+    for (auto const& p : sarena_thread_heaps.m_heaps) {
+        if (p.first == m_id) {
+            mine = (p.second == owner);
+            break;
+        }
+    }
+
+    if (mine)
+    {
+        *reinterpret_cast<void**>(vp) = sc.m_free;
+        sc.m_free = h;
+    }
+    else
+    {
+        void* head = sc.m_remote.load(std::memory_order_relaxed);
+        do {
+            *reinterpret_cast<void**>(vp) = head;
+        } while (!sc.m_remote.compare_exchange_weak(head, h,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed));
+    }
+}
+
+std::size_t
+SArena::heap_space_used () const noexcept
+{
+    return m_used.load(std::memory_order_relaxed) + m_large->heap_space_used();
+}
+
+std::size_t
+SArena::heap_space_actually_used () const noexcept
+{
+    std::size_t r = m_large->heap_space_actually_used();
+    std::lock_guard<std::mutex> lock(sarena_mutex);
+    for (auto const& heap : m_heaps) {
+        r += heap->m_actually_used.load(std::memory_order_relaxed);
+    }
+    return r;
+}
+
+std::size_t
+SArena::sizeOf (void* p) const noexcept
+{
+    if (p == nullptr) {
+        return 0;
+    } else {
+        const Header* h = static_cast<const Header*>(p) - 1;
+        return (h->m_owner) ? m_class_size[h->m_cls] : h->m_cls;
+    }
+}
+
+void
+SArena::PrintUsage (std::string const& name) const
+{
+    Long min_megabytes = heap_space_used() / (1024*1024);
+    Long max_megabytes = min_megabytes;
+    Long actual_min_megabytes = heap_space_actually_used() / (1024*1024);
+    Long actual_max_megabytes = actual_min_megabytes;
+    const int IOProc = ParallelDescriptor::IOProcessorNumber();
+    ParallelReduce::Min<Long>({min_megabytes, actual_min_megabytes},
+                              IOProc, ParallelDescriptor::Communicator());
+    ParallelReduce::Max<Long>({max_megabytes, actual_max_megabytes},
+                              IOProc, ParallelDescriptor::Communicator());
+#ifdef AMREX_USE_MPI
+    amrex::Print() << "[" << name << "]" << " space (MB) allocated spread across MPI: ["
+                   << min_megabytes << " ... " << max_megabytes << "]\n"
+                   << "[" << name << "]" << " space (MB) used      spread across MPI: ["
+                   << actual_min_megabytes << " ... " << actual_max_megabytes << "]\n";
+#else
+    amrex::Print() << "[" << name << "]" << " space allocated (MB): " << min_megabytes << "\n";
+    amrex::Print() << "[" << name << "]" << " space used      (MB): " << actual_min_megabytes << "\n";
+#endif
+}
+
+}
@@ -30,6 +30,7 @@ std::map<std::string, VisMF::PersistentIFStream> VisMF::persistentIFStreams;
 
 int VisMF::verbose(0);
 VisMF::Header::Version VisMF::currentVersion(VisMF::Header::Version_v1);
+int VisMF::compressionLevel(1);
 bool VisMF::groupSets(false);
 bool VisMF::setBuf(true);
 bool VisMF::useSingleRead(false);
@@ -51,6 +52,71 @@ int VisMF::nMFFileInStreams(4);
 namespace
 {
     bool initialized = false;
+
+    //
+    // Append each component of fab, converted to rd, to buf as a separately
+    // compressed chunk.  The size of each chunk is appended to csize.
+    // Components with a positive error bound are compressed lossily from
+    // the native format.
+    //
+    void CompressFab (const FArrayBox& fab, const RealDescriptor& rd,
+                      Compression::Codec codec, int level, const Vector<Real>& errbound,
+                      Vector<char>& buf, Vector<Long>& csize)
+    {
+        const Long npts(fab.box().numPts());
+        const int rdBytes(rd.numBytes());
+        const bool doConvert(rd != FPC::NativeRealDescriptor());
+        Vector<char> cvt(doConvert ? npts * rdBytes : 0);
+        for(int n(0); n < fab.nComp(); ++n) {
+            const Long before(buf.size());
+            if(errbound[n] > 0.0) {
+                Compression::CompressQuantized(codec, level, fab.dataPtr(n), npts,
+                                               errbound[n], buf);
+                csize.push_back(buf.size() - before);
+                continue;
+            }
+            const void *src = fab.dataPtr(n);
+            if(doConvert) {
+                RealDescriptor::convertFromNativeFormat(cvt.dataPtr(), npts, fab.dataPtr(n), rd);
+                src = cvt.dataPtr();
+            }
+            Compression::Compress(codec, level, src, npts * rdBytes, rdBytes, buf);
+            csize.push_back(buf.size() - before);
+        }
+    }
+
+    //
+    // Read ncomp compressed components of fab idx starting at scomp into fab
+    // starting at dcomp.  The stream must be positioned at the start of fab idx.
+    //
+    void ReadCompressedFab (FArrayBox& fab, int dcomp, int scomp, int ncomp,
+                            int idx, std::istream& is, const VisMF::Header& hdr)
+    {
+        const Vector<Long> &chunk = hdr.m_chunk[idx];
+        const Long npts(fab.box().numPts());
+        const int rdBytes(hdr.m_writtenRD.numBytes());
+        const bool doConvert(hdr.m_writtenRD != FPC::NativeRealDescriptor());
+        Vector<char> cbuf, raw(doConvert ? npts * rdBytes : 0);
+        is.seekg(chunk[scomp], std::ios::cur);
+        for(int n(0); n < ncomp; ++n) {
+            cbuf.resize(chunk[scomp+n+1] - chunk[scomp+n]);
+            is.read(cbuf.dataPtr(), cbuf.size());
+            const Real errbound(hdr.m_errbound[scomp+n]);
+            if(errbound > 0.0) {
+                Compression::DecompressQuantized(hdr.m_codec, cbuf.dataPtr(), cbuf.size(),
+                                                 fab.dataPtr(dcomp+n), npts, errbound);
+                continue;
+            }
+            void *dst = doConvert ? static_cast<void *>(raw.dataPtr())
+                                  : static_cast<void *>(fab.dataPtr(dcomp+n));
+            Compression::Decompress(hdr.m_codec, cbuf.dataPtr(), cbuf.size(),
+                                    dst, npts * rdBytes, rdBytes);
+            if(doConvert) {
+                RealDescriptor::convertToNativeFormat(fab.dataPtr(dcomp+n), npts,
+                                                      raw.dataPtr(), hdr.m_writtenRD);
+            }
+        }
+    }
 }
 
 void
@@ -76,6 +142,14 @@ VisMF::Initialize ()
     if(headerVersion != currentVersion) {
       currentVersion = static_cast<VisMF::Header::Version> (headerVersion);
     }
+    pp.query("compressionlevel", compressionLevel);
+    if(currentVersion == VisMF::Header::Compressed_v1 &&
+       Compression::DefaultCodec() == Compression::None &&
+       ParallelDescriptor::IOProcessor())
+    {
+      amrex::Warning("VisMF: no compression library available, "
+                     "vismf.headerversion = 5 will store uncompressed data");
+    }
 
     pp.query("groupsets", groupSets);
     pp.query("setbuf", setBuf);
@@ -284,8 +358,9 @@ operator<< (std::ostream        &os,
 
     os << hd.m_fod      << '\n';
 
-    if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(hd.m_vers == VisMF::Header::Version_v1           ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       os << hd.m_min      << '\n';
       os << hd.m_max      << '\n';
@@ -317,6 +392,24 @@ operator<< (std::ostream        &os,
       }
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      BL_ASSERT(hd.m_chunk.size() == hd.m_ba.size());
+      os << hd.m_writtenRD << '\n';
+      os << Compression::CodecName(hd.m_codec) << '\n';
+      BL_ASSERT(hd.m_errbound.size() == hd.m_ncomp);
+      for(int i(0); i < hd.m_errbound.size(); ++i) {
+        os << hd.m_errbound[i] << ' ';
+      }
+      os << '\n';
+      for(int i(0); i < hd.m_chunk.size(); ++i) {
+        BL_ASSERT(hd.m_chunk[i].size() == hd.m_ncomp+1);
+        for(int j(0); j < hd.m_chunk[i].size(); ++j) {
+          os << hd.m_chunk[i][j] << ' ';
+        }
+        os << '\n';
+      }
+    }
+
     os.flags(oflags);
     os.precision(oldPrec);
 
@@ -368,8 +461,9 @@ operator>> (std::istream  &is,
     is >> hd.m_fod;
     BL_ASSERT(hd.m_ba.size() == hd.m_fod.size());
 
-    if(hd.m_vers == VisMF::Header::Version_v1 ||
-       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(hd.m_vers == VisMF::Header::Version_v1           ||
+       hd.m_vers == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       hd.m_vers == VisMF::Header::Compressed_v1)
     {
       is >> hd.m_min;
       is >> hd.m_max;
@@ -401,6 +495,23 @@ operator>> (std::istream  &is,
       is >> hd.m_writtenRD;
     }
 
+    if(hd.m_vers == VisMF::Header::Compressed_v1) {
+      is >> hd.m_writtenRD;
+      std::string codec;
+      is >> codec;
+      hd.m_codec = Compression::CodecFromName(codec);
+      hd.m_errbound.resize(hd.m_ncomp);
+      for(int i(0); i < hd.m_errbound.size(); ++i) {
+        is >> hd.m_errbound[i];
+      }
+      hd.m_chunk.resize(hd.m_ba.size());
+      for(int i(0); i < hd.m_chunk.size(); ++i) {
+        hd.m_chunk[i].resize(hd.m_ncomp+1);
+        for(int j(0); j < hd.m_chunk[i].size(); ++j) {
+          is >> hd.m_chunk[i][j];
+        }
+      }
+    }
 
     if( ! is.good()) {
         amrex::Error("Read of VisMF::Header failed");
@@ -942,11 +1053,16 @@ Long
 VisMF::Write (const FabArray<FArrayBox>&    mf,
               const std::string& mf_name,
               VisMF::How         how,
-              bool               set_ghost)
+              bool               set_ghost,
+              const Vector<Real>& errbound)
 {
     BL_PROFILE("VisMF::Write(FabArray)");
     BL_ASSERT(mf_name[mf_name.length() - 1] != '/');
     BL_ASSERT(currentVersion != VisMF::Header::Undefined_v1);
+    BL_ASSERT(errbound.empty() || errbound.size() == mf.nComp());
+
+    const VisMF::Header::Version version(errbound.empty() ? currentVersion
+                                                          : VisMF::Header::Compressed_v1);
 
     // ---- add stream retry
     // ---- add stream buffer (to nfiles)
@@ -1011,13 +1127,42 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
     int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
     Long bytesWritten(0);
     bool calcMinMax(false);
-    VisMF::Header hdr(mf, how, currentVersion, calcMinMax);
+    VisMF::Header hdr(mf, how, version, calcMinMax);
 
     std::string filePrefix(mf_name + FabFileSuffix);
 
     NFilesIter nfi(nOutFiles, filePrefix, groupSets, setBuf);
 
-    bool oldHeader(currentVersion == VisMF::Header::Version_v1);
+    bool oldHeader(version == VisMF::Header::Version_v1);
+
+    // ---- compress the fabs before writing, the offsets depend on the sizes
+    bool compressed(version == VisMF::Header::Compressed_v1);
+    Vector< Vector<char> > compressedData;
+    if(compressed) {
+        hdr.m_writtenRD = *whichRD;
+        hdr.m_codec = Compression::DefaultCodec();
+        hdr.m_errbound = errbound;
+        hdr.m_errbound.resize(mf.nComp(), 0.0);
+        hdr.m_chunk.resize(hdr.m_ba.size());
+        Vector<const FArrayBox *> localFabs;
+        Vector<int> localIndex;
+        for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+            localFabs.push_back(&mf[mfi]);
+            localIndex.push_back(mfi.index());
+        }
+        compressedData.resize(localFabs.size());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < localFabs.size(); ++i) {
+            Vector<Long> csize;
+            CompressFab(*localFabs[i], *whichRD, hdr.m_codec, compressionLevel,
+                        hdr.m_errbound, compressedData[i], csize);
+            Vector<Long> &chunk = hdr.m_chunk[localIndex[i]];
+            chunk.resize(csize.size() + 1, 0);
+            std::partial_sum(csize.begin(), csize.end(), chunk.begin() + 1);
+        }
+    }
 
     if(useSparseFPP) {
         nfi.SetSparseFPP(procsWithDataVector);
@@ -1036,12 +1181,16 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
                 fio.write_header(hss, fab, fab.nComp());
                 bytesWritten += static_cast<std::streamoff>(hss.tellp());
             }
-            bytesWritten += fab.box().numPts() * mf.nComp() * whichRDBytes;
+            if(compressed) {
+                bytesWritten += compressedData[nFABs].size();
+            } else {
+                bytesWritten += fab.box().numPts() * mf.nComp() * whichRDBytes;
+            }
             ++nFABs;
         }
         char *allFabData(nullptr);
         bool canCombineFABs(false);
-        if((nFABs > 1 || doConvert) && VisMF::useSingleWrite) {
+        if((nFABs > 1 || doConvert) && VisMF::useSingleWrite && ! compressed) {
             allFabData = new(std::nothrow) char[bytesWritten];
         }    // ---- else { no need to make a copy for one fab }
         if(allFabData == nullptr) {
@@ -1078,6 +1227,12 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
             nfi.Stream().flush();
             delete [] allFabData;
 
+        } else if(compressed) {
+            for(int i(0); i < compressedData.size(); ++i) {
+                nfi.Stream().write(compressedData[i].dataPtr(), compressedData[i].size());
+                nfi.Stream().flush();
+            }
+
         } else {    // ---- write fabs individually
             for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
                 int hLength(0);
@@ -1116,13 +1271,14 @@ VisMF::Write (const FabArray<FArrayBox>&    mf,
         amrex::prefetchToDevice(mf);  // CalculateMinMax might do work on device
     }
 
-    if(currentVersion == VisMF::Header::Version_v1 ||
-       currentVersion == VisMF::Header::NoFabHeaderMinMax_v1)
+    if(version == VisMF::Header::Version_v1           ||
+       version == VisMF::Header::NoFabHeaderMinMax_v1 ||
+       version == VisMF::Header::Compressed_v1)
     {
         hdr.CalculateMinMax(mf, coordinatorProc);
     }
 
-    VisMF::FindOffsets(mf, filePrefix, hdr, currentVersion, nfi,
+    VisMF::FindOffsets(mf, filePrefix, hdr, version, nfi,
                        ParallelDescriptor::Communicator());
 
     bytesWritten += VisMF::WriteHeader(mf_name, hdr, coordinatorProc);
@@ -1158,6 +1314,10 @@ VisMF::WriteOnlyHeader (const FabArray<FArrayBox> & mf,
         fod.m_name = "Not Saved";
         fod.m_head = -1;
     }
+    if(hdr.m_vers == VisMF::Header::Compressed_v1) {
+        hdr.m_chunk.assign(hdr.m_ba.size(), Vector<Long>(1, 0));
+        hdr.m_errbound.clear();
+    }
 
     // Write header on the IOProcessorNumber 
     int coordinatorProc(ParallelDescriptor::IOProcessorNumber());
@@ -1265,6 +1425,64 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
       int whichRDBytes(whichRD->numBytes());
       int nComps(mf.nComp());
 
+#ifdef BL_USE_MPI
+      if(hdr.m_vers == VisMF::Header::Compressed_v1) {
+        // ---- the coordinator needs the compressed component sizes of all fabs
+        Vector<int> nmtags(nProcs,0);
+        Vector<int> offset(nProcs,0);
+
+        const Vector<int> &pmap = mf.DistributionMap().ProcessorMap();
+
+        for(int i(0), N(mf.size()); i < N; ++i) {
+          nmtags[pmap[i]] += nComps;
+        }
+
+        for(int i(1), N(offset.size()); i < N; ++i) {
+          offset[i] = offset[i-1] + nmtags[i-1];
+        }
+
+        Vector<Long> senddata;
+        for(MFIter mfi(mf); mfi.isValid(); ++mfi) {
+          const Vector<Long> &chunk = hdr.m_chunk[mfi.index()];
+          senddata.insert(senddata.end(), chunk.begin() + 1, chunk.end());
+        }
+
+        BL_ASSERT(senddata.size() == nmtags[myProc]);
+
+        if(senddata.empty()) {
+          // Can't let senddata be empty as senddata.dataPtr() will fail.
+          senddata.resize(1);
+        }
+
+        Vector<Long> recvdata(myProc == coordinatorProc ? mf.size() * nComps : 1);
+
+        BL_MPI_REQUIRE( MPI_Gatherv(senddata.dataPtr(),
+                                    nmtags[myProc],
+                                    ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                    recvdata.dataPtr(),
+                                    nmtags.dataPtr(),
+                                    offset.dataPtr(),
+                                    ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                    coordinatorProc,
+                                    comm) );
+
+        if(myProc == coordinatorProc) {
+          Vector<int> cnt(nProcs,0);
+
+          for(int j(0), N(mf.size()); j < N; ++j) {
+            const int i(pmap[j]);
+            Vector<Long> &chunk = hdr.m_chunk[j];
+            chunk.resize(nComps + 1);
+            chunk[0] = 0;
+            for(int n(0); n < nComps; ++n) {
+              chunk[n+1] = recvdata[offset[i] + cnt[i] + n];
+            }
+            cnt[i] += nComps;
+          }
+        }
+      }
+#endif
+
       if(myProc == coordinatorProc) {   // ---- calculate offsets
 	const BoxArray &mfBA = mf.boxArray();
 	const DistributionMapping &mfDM = mf.DistributionMap();
@@ -1321,8 +1539,12 @@ VisMF::FindOffsets (const FabArray<FArrayBox> &mf,
 	      for(int i(0); i < index.size(); ++i) {
                  hdr.m_fod[index[i]].m_name = whichFileName;
                  hdr.m_fod[index[i]].m_head = currentOffset[whichFileNumber];
-                 currentOffset[whichFileNumber] += mf.fabbox(index[i]).numPts() * nComps * whichRDBytes
-	                                           + fabHeaderBytes[index[i]];
+                 if(hdr.m_vers == VisMF::Header::Compressed_v1) {
+                   currentOffset[whichFileNumber] += hdr.m_chunk[index[i]].back();
+                 } else {
+                   currentOffset[whichFileNumber] += mf.fabbox(index[i]).numPts() * nComps * whichRDBytes
+	                                             + fabHeaderBytes[index[i]];
+                 }
               }
             }
 	  }
@@ -1417,7 +1639,13 @@ VisMF::readFAB (int                  idx,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(hdr.m_vers == Header::Version_v1) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      if(whichComp == -1) {    // ---- read all components
+        ReadCompressedFab(*fab, 0, 0, hdr.m_ncomp, idx, *infs, hdr);
+      } else {                 // ---- seek to the one component
+        ReadCompressedFab(*fab, 0, whichComp, 1, idx, *infs, hdr);
+      }
+    } else if(hdr.m_vers == Header::Version_v1) {
       if(whichComp == -1) {    // ---- read all components
         fab->readFrom(*infs);
       } else {
@@ -1467,7 +1695,9 @@ VisMF::readFAB (FabArray<FArrayBox> &mf,
     std::ifstream *infs = VisMF::OpenStream(FullName);
     infs->seekg(hdr.m_fod[idx].m_head, std::ios::beg);
 
-    if(NoFabHeader(hdr)) {
+    if(hdr.m_vers == Header::Compressed_v1) {
+      ReadCompressedFab(fab, 0, 0, hdr.m_ncomp, idx, *infs, hdr);
+    } else if(NoFabHeader(hdr)) {
       if(hdr.m_writtenRD == FPC::NativeRealDescriptor()) {
         infs->read((char *) fab.dataPtr(), fab.nBytes());
       } else {
@@ -2178,40 +2408,42 @@ void VisMF::CloseAllStreams() {
 
 
 void
-VisMF::AsyncWrite (const FabArray<FArrayBox>& mf, const std::string& mf_name, bool valid_cells_only)
+VisMF::AsyncWrite (const FabArray<FArrayBox>& mf, const std::string& mf_name, bool valid_cells_only,
+                   const Vector<Real>& errbound)
 {
     if (AsyncOut::UseAsyncOut()) {
-        AsyncWriteDoit(mf, mf_name, false, valid_cells_only);
+        AsyncWriteDoit(mf, mf_name, false, valid_cells_only, errbound);
     } else {
         if (valid_cells_only and mf.nGrowVect() != 0) {
             FabArray<FArrayBox> mf_tmp(mf.boxArray(), mf.DistributionMap(), mf.nComp(), 0);
             amrex::Copy(mf_tmp, mf, 0, 0, mf.nComp(), 0);
-            Write(mf_tmp, mf_name);
+            Write(mf_tmp, mf_name, NFiles, false, errbound);
         } else {
-            Write(mf, mf_name);
+            Write(mf, mf_name, NFiles, false, errbound);
         }
     }
 }
 
 void
-VisMF::AsyncWrite (FabArray<FArrayBox>&& mf, const std::string& mf_name, bool valid_cells_only)
+VisMF::AsyncWrite (FabArray<FArrayBox>&& mf, const std::string& mf_name, bool valid_cells_only,
+                   const Vector<Real>& errbound)
 {
     if (AsyncOut::UseAsyncOut()) {
-        AsyncWriteDoit(mf, mf_name, true, valid_cells_only);
+        AsyncWriteDoit(mf, mf_name, true, valid_cells_only, errbound);
     } else {
         if (valid_cells_only and mf.nGrowVect() != 0) {
             FabArray<FArrayBox> mf_tmp(mf.boxArray(), mf.DistributionMap(), mf.nComp(), 0);
             amrex::Copy(mf_tmp, mf, 0, 0, mf.nComp(), 0);
-            Write(mf_tmp, mf_name);
+            Write(mf_tmp, mf_name, NFiles, false, errbound);
         } else {
-            Write(mf, mf_name);
+            Write(mf, mf_name, NFiles, false, errbound);
         }
     }
 }
 
 void
 VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name,
-                       bool is_rvalue, bool valid_cells_only)
+                       bool is_rvalue, bool valid_cells_only, const Vector<Real>& errbound)
 {
     BL_PROFILE("VisMF::AsyncWrite()");
 
@@ -2227,8 +2459,19 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
 
     RealDescriptor const& whichRD = FPC::NativeRealDescriptor();
 
-    auto hdr = std::make_shared<VisMF::Header>(mf, VisMF::NFiles, VisMF::Header::Version_v1, false);
+    const bool compressed = (currentVersion == VisMF::Header::Compressed_v1 or not errbound.empty());
+
+    auto hdr = std::make_shared<VisMF::Header>(mf, VisMF::NFiles,
+                                               compressed ? VisMF::Header::Compressed_v1
+                                                          : VisMF::Header::Version_v1,
+                                               false);
     if (valid_cells_only) hdr->m_ngrow = IntVect(0);
+    if (compressed) {
+        hdr->m_writtenRD = whichRD;
+        hdr->m_codec = Compression::DefaultCodec();
+        hdr->m_errbound = errbound;
+        hdr->m_errbound.resize(mf.nComp(), 0.0);
+    }
 
     constexpr int sizeof_int64_over_real = sizeof(int64_t) / sizeof(Real);
     const int n_local_fabs = mf.local_size();
@@ -2312,6 +2555,14 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
     }
 #endif
 
+    // Reserve the memory budget of AsyncOut before the data are copied.
+    std::size_t job_bytes = 0;
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        Box bx = strip_ghost ? mfi.validbox() : mfi.fabbox();
+        job_bytes += bx.numPts() * mf.nComp() * sizeof(Real);
+    }
+    AsyncOut::Reserve(job_bytes);
+
     auto myfabs = std::make_shared<Vector<FArrayBox> >();
     for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
         Box bx = strip_ghost ? mfi.validbox() : mfi.fabbox();
@@ -2339,8 +2590,63 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
 
     std::shared_ptr<FABio> fabio(new FABio_binary(FPC::NativeRealDescriptor().clone()));
 
+    // With Compressed_v1 the file offsets depend on the compressed sizes.  The
+    // fabs are compressed and the sizes gathered to io_proc on the AsyncOut
+    // thread if it can call MPI, and here otherwise.
+    auto cdata = std::make_shared<Vector<Vector<char> > >();
+    auto csize = std::make_shared<Vector<Long> >(); // [fab][comp] in rank order on io_proc
+    const int level = compressionLevel;
+    auto compress_fabs = [=] (MPI_Comm comm)
+    {
+        amrex::ignore_unused(comm);
+        Vector<Long> lsize;
+        cdata->resize(myfabs->size());
+        for (int i = 0; i < myfabs->size(); ++i) {
+            CompressFab((*myfabs)[i], hdr->m_writtenRD, hdr->m_codec, level, hdr->m_errbound,
+                        (*cdata)[i], lsize);
+        }
+        myfabs->clear();
+
+        if (nprocs == 1) {
+            *csize = std::move(lsize);
+        }
+#ifdef BL_USE_MPI
+        else {
+            Vector<int> rcnt, rdsp;
+            if (myproc == io_proc) {
+                csize->resize(n_global_fabs*ncomp);
+                rcnt.resize(nprocs,0);
+                rdsp.resize(nprocs,0);
+                for (int k = 0; k < n_global_fabs; ++k) {
+                    rcnt[dm[k]] += ncomp;
+                }
+                std::partial_sum(rcnt.begin(), rcnt.end()-1, rdsp.begin()+1);
+            } else {
+                csize->resize(1,0);
+                rcnt.resize(1,0);
+                rdsp.resize(1,0);
+            }
+            BL_MPI_REQUIRE(MPI_Gatherv(lsize.data(), lsize.size(),
+                                       ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                       csize->data(), rcnt.data(), rdsp.data(),
+                                       ParallelDescriptor::Mpi_typemap<Long>::type(),
+                                       io_proc, comm));
+        }
+#endif
+    };
+
+    const bool compress_on_thread = compressed and
+        (nprocs == 1 or AsyncOut::Communicator() != MPI_COMM_NULL);
+    if (compressed and not compress_on_thread) {
+        compress_fabs(ParallelDescriptor::Communicator());
+    }
+
     AsyncOut::Submit([=] ()
     {
+        if (compress_on_thread) {
+            compress_fabs(AsyncOut::Communicator());
+        }
+
         if (myproc == io_proc)
         {
             hdr->m_fod.resize(n_global_fabs);
@@ -2404,6 +2710,24 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
                 }
             }
 
+            if (compressed) {
+                hdr->m_chunk.resize(n_global_fabs);
+                nbytes_on_rank.assign(nprocs, 0);
+                const Long* pcs = csize->data();
+                for (int rank = 0; rank < nprocs; ++rank) {
+                    for (int k : gidx[rank]) {
+                        Vector<Long>& chunk = hdr->m_chunk[k];
+                        chunk.resize(ncomp+1);
+                        chunk[0] = 0;
+                        for (int icomp = 0; icomp < ncomp; ++icomp) {
+                            chunk[icomp+1] = chunk[icomp] + *pcs++;
+                        }
+                        hdr->m_fod[k].m_head = nbytes_on_rank[rank];
+                        nbytes_on_rank[rank] += chunk[ncomp];
+                    }
+                }
+            }
+
             Vector<int64_t> offset(nprocs);
             for (int ip = 0; ip < nprocs; ++ip) {
                 auto info = AsyncOut::GetWriteInfo(ip);
@@ -2432,15 +2756,21 @@ VisMF::AsyncWriteDoit (const FabArray<FArrayBox>& mf, const std::string& mf_name
         ofs.open(file_name.c_str(), (info.ispot == 0) ? (std::ios::binary | std::ios::trunc)
                                                       : (std::ios::binary | std::ios::app));
         if (!ofs.good()) amrex::FileOpenFailed(file_name);
-        for (auto const& fab : *myfabs) {
-            fabio->write_header(ofs, fab, fab.nComp());
-            fabio->write(ofs, fab, 0, fab.nComp());
+        if (compressed) {
+            for (auto const& buf : *cdata) {
+                ofs.write(buf.data(), buf.size());
+            }
+        } else {
+            for (auto const& fab : *myfabs) {
+                fabio->write_header(ofs, fab, fab.nComp());
+                fabio->write(ofs, fab, 0, fab.nComp());
+            }
         }
         ofs.flush();
         ofs.close();
 
         AsyncOut::Notify();  // Notify others I am done
-    });
+    }, job_bytes, true);
 }
 
 }
@@ -10,9 +10,10 @@ MLABecLaplacian::MLABecLaplacian (const Vector<Geometry>& a_geom,
                                   const Vector<BoxArray>& a_grids,
                                   const Vector<DistributionMapping>& a_dmap,
                                   const LPInfo& a_info,
-                                  const Vector<FabFactory<FArrayBox> const*>& a_factory)
+                                  const Vector<FabFactory<FArrayBox> const*>& a_factory,
+                                  const int a_ncomp)
 {
-    define(a_geom, a_grids, a_dmap, a_info, a_factory);
+    define(a_geom, a_grids, a_dmap, a_info, a_factory, a_ncomp);
 }
 
 MLABecLaplacian::MLABecLaplacian (const Vector<Geometry>& a_geom,
@@ -20,9 +21,10 @@ MLABecLaplacian::MLABecLaplacian (const Vector<Geometry>& a_geom,
                                   const Vector<DistributionMapping>& a_dmap,
                                   const Vector<iMultiFab const*>& a_overset_mask,
                                   const LPInfo& a_info,
-                                  const Vector<FabFactory<FArrayBox> const*>& a_factory)
+                                  const Vector<FabFactory<FArrayBox> const*>& a_factory,
+                                  const int a_ncomp)
 {
-    define(a_geom, a_grids, a_dmap, a_overset_mask, a_info, a_factory);
+    define(a_geom, a_grids, a_dmap, a_overset_mask, a_info, a_factory, a_ncomp);
 }
 
 void
@@ -30,10 +32,14 @@ MLABecLaplacian::define (const Vector<Geometry>& a_geom,
                          const Vector<BoxArray>& a_grids,
                          const Vector<DistributionMapping>& a_dmap,
                          const LPInfo& a_info,
-                         const Vector<FabFactory<FArrayBox> const*>& a_factory)
+                         const Vector<FabFactory<FArrayBox> const*>& a_factory,
+                         const int a_ncomp)
 {
     BL_PROFILE("MLABecLaplacian::define()");
 
+    AMREX_ALWAYS_ASSERT(a_ncomp >= 1);
+    m_ncomp = a_ncomp;
+
     MLCellABecLap::define(a_geom, a_grids, a_dmap, a_info, a_factory);
 
     const int ncomp = getNComp();
@@ -46,18 +52,20 @@ MLABecLaplacian::define (const Vector<Geometry>& a_geom,
         m_a_coeffs[amrlev].resize(m_num_mg_levels[amrlev]);
         m_b_coeffs[amrlev].resize(m_num_mg_levels[amrlev]);
         m_overset_mask[amrlev].resize(m_num_mg_levels[amrlev]);
+        // ghost cells for smoothing with deep ghost cells
+        const int ng = (amrlev == 0) ? std::max(info.smooth_ngrow-1, 0) : 0;
         for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev)
         {
             m_a_coeffs[amrlev][mglev].define(m_grids[amrlev][mglev],
                                              m_dmap[amrlev][mglev],
-                                             1, 0, MFInfo(), *m_factory[amrlev][mglev]);
+                                             1, ng, MFInfo(), *m_factory[amrlev][mglev]);
             for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
             {
                 const BoxArray& ba = amrex::convert(m_grids[amrlev][mglev],
                                                     IntVect::TheDimensionVector(idim));
                 m_b_coeffs[amrlev][mglev][idim].define(ba,
                                                        m_dmap[amrlev][mglev],
-                                                       ncomp, 0, MFInfo(), *m_factory[amrlev][mglev]);
+                                                       ncomp, ng, MFInfo(), *m_factory[amrlev][mglev]);
             }
         }
     }
@@ -69,7 +77,8 @@ MLABecLaplacian::define (const Vector<Geometry>& a_geom,
                          const Vector<DistributionMapping>& a_dmap,
                          const Vector<iMultiFab const*>& a_overset_mask,
                          const LPInfo& a_info,
-                         const Vector<FabFactory<FArrayBox> const*>& a_factory)
+                         const Vector<FabFactory<FArrayBox> const*>& a_factory,
+                         const int a_ncomp)
 {
     BL_PROFILE("MLABecLaplacian::define(overset)");
 
@@ -129,7 +138,7 @@ MLABecLaplacian::define (const Vector<Geometry>& a_geom,
     LPInfo linfo = a_info;
     linfo.max_coarsening_level = std::min(a_info.max_coarsening_level,
                                           max_overset_mask_coarsening_level);
-    define(a_geom, a_grids, a_dmap, linfo, a_factory);
+    define(a_geom, a_grids, a_dmap, linfo, a_factory, a_ncomp);
 
     amrlev = 0;
     for (int mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev) {
@@ -237,6 +246,70 @@ MLABecLaplacian::averageDownCoeffs ()
     }
 
     averageDownCoeffsSameAmrLevel(0, m_a_coeffs[0], m_b_coeffs[0]);
+
+    if (m_a_coeffs[0][0].nGrow() > 0) {
+        for (int mglev = 0; mglev < m_num_mg_levels[0]; ++mglev) {
+            const Periodicity period = m_geom[0][mglev].periodicity();
+            m_a_coeffs[0][mglev].FillBoundary(period);
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                m_b_coeffs[0][mglev][idim].FillBoundary(period);
+            }
+        }
+    }
+
+    if (info.mixed_precision) makeSinglePrecisionCoeffs();
+}
+
+void
+MLABecLaplacian::makeSinglePrecisionCoeffs ()
+{
+    BL_PROFILE("MLABecLaplacian::makeSinglePrecisionCoeffs()");
+
+    const int ncomp = getNComp();
+
+    m_a_coeffs_sp.resize(m_num_amr_levels);
+    m_b_coeffs_sp.resize(m_num_amr_levels);
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+    {
+        m_a_coeffs_sp[amrlev].resize(m_num_mg_levels[amrlev]);
+        m_b_coeffs_sp[amrlev].resize(m_num_mg_levels[amrlev]);
+        for (int mglev = 1; mglev < m_num_mg_levels[amrlev]; ++mglev)
+        {
+            auto& a = m_a_coeffs_sp[amrlev][mglev];
+            auto& b = m_b_coeffs_sp[amrlev][mglev];
+            const int ng = m_a_coeffs[amrlev][mglev].nGrow();
+            if (a.empty()) {
+                a.define(m_a_coeffs[amrlev][mglev].boxArray(), m_dmap[amrlev][mglev], 1, ng);
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    b[idim].define(m_b_coeffs[amrlev][mglev][idim].boxArray(),
+                                   m_dmap[amrlev][mglev], ncomp, ng);
+                }
+            }
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(a,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.growntilebox();
+                Array4<float> const& af = a.array(mfi);
+                Array4<Real const> const& ad = m_a_coeffs[amrlev][mglev].const_array(mfi);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_3D(bx, i, j, k,
+                {
+                    af(i,j,k) = static_cast<float>(ad(i,j,k));
+                });
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    const Box& nbx = mfi.grownnodaltilebox(idim);
+                    Array4<float> const& bf = b[idim].array(mfi);
+                    Array4<Real const> const& bd = m_b_coeffs[amrlev][mglev][idim].const_array(mfi);
+                    AMREX_HOST_DEVICE_PARALLEL_FOR_4D(nbx, ncomp, i, j, k, n,
+                    {
+                        bf(i,j,k,n) = static_cast<float>(bd(i,j,k,n));
+                    });
+                }
+            }
+        }
+    }
 }
 
 void
@@ -376,6 +449,11 @@ MLABecLaplacian::prepareForSolve ()
         }
     }
 
+    // The tensor operators have cross terms that normalize does not see.
+    if (!isTensorOp()) {
+        computeChebyshevBounds();
+    }
+
     m_needs_update = false;
 }
 
@@ -384,10 +462,26 @@ MLABecLaplacian::Fapply (int amrlev, int mglev, MultiFab& out, const MultiFab& i
 {
     BL_PROFILE("MLABecLaplacian::Fapply()");
 
-    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
-    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
-                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
-                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+    if (useSinglePrecision(mglev)) {
+        FapplyT(amrlev, mglev, out, in, m_a_coeffs_sp[amrlev][mglev],
+                amrex::GetArrOfConstPtrs(m_b_coeffs_sp[amrlev][mglev]));
+    } else {
+        FapplyT<FArrayBox>(amrlev, mglev, out, in, m_a_coeffs[amrlev][mglev],
+                           {AMREX_D_DECL(&m_b_coeffs[amrlev][mglev][0],
+                                         &m_b_coeffs[amrlev][mglev][1],
+                                         &m_b_coeffs[amrlev][mglev][2])});
+    }
+}
+
+template <typename FAB>
+void
+MLABecLaplacian::FapplyT (int amrlev, int mglev, MultiFab& out, const MultiFab& in,
+                          FabArray<FAB> const& acoef,
+                          Array<FabArray<FAB> const*,AMREX_SPACEDIM> const& bcoef) const
+{
+    AMREX_D_TERM(FabArray<FAB> const& bxcoef = *bcoef[0];,
+                 FabArray<FAB> const& bycoef = *bcoef[1];,
+                 FabArray<FAB> const& bzcoef = *bcoef[2];);
 
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
 
@@ -430,10 +524,26 @@ MLABecLaplacian::normalize (int amrlev, int mglev, MultiFab& mf) const
 {
     BL_PROFILE("MLABecLaplacian::normalize()");
 
-    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
-    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
-                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
-                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
+    if (useSinglePrecision(mglev)) {
+        normalizeT(amrlev, mglev, mf, m_a_coeffs_sp[amrlev][mglev],
+                   amrex::GetArrOfConstPtrs(m_b_coeffs_sp[amrlev][mglev]));
+    } else {
+        normalizeT<FArrayBox>(amrlev, mglev, mf, m_a_coeffs[amrlev][mglev],
+                              {AMREX_D_DECL(&m_b_coeffs[amrlev][mglev][0],
+                                            &m_b_coeffs[amrlev][mglev][1],
+                                            &m_b_coeffs[amrlev][mglev][2])});
+    }
+}
+
+template <typename FAB>
+void
+MLABecLaplacian::normalizeT (int amrlev, int mglev, MultiFab& mf,
+                             FabArray<FAB> const& acoef,
+                             Array<FabArray<FAB> const*,AMREX_SPACEDIM> const& bcoef) const
+{
+    AMREX_D_TERM(FabArray<FAB> const& bxcoef = *bcoef[0];,
+                 FabArray<FAB> const& bycoef = *bcoef[1];,
+                 FabArray<FAB> const& bzcoef = *bcoef[2];);
 
     const auto dxinv = m_geom[amrlev][mglev].InvCellSizeArray();
 
@@ -467,17 +577,64 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 {
     BL_PROFILE("MLABecLaplacian::Fsmooth()");
 
+    if (useSinglePrecision(mglev)) {
+        FsmoothT(amrlev, mglev, sol, rhs, redblack, m_a_coeffs_sp[amrlev][mglev],
+                 amrex::GetArrOfConstPtrs(m_b_coeffs_sp[amrlev][mglev]));
+    } else {
+        FsmoothT<FArrayBox>(amrlev, mglev, sol, rhs, redblack, m_a_coeffs[amrlev][mglev],
+                            {AMREX_D_DECL(&m_b_coeffs[amrlev][mglev][0],
+                                          &m_b_coeffs[amrlev][mglev][1],
+                                          &m_b_coeffs[amrlev][mglev][2])});
+    }
+}
+
+void
+MLABecLaplacian::FsmoothDeep (int mglev, MultiFab& sol, const MultiFab& rhs,
+                              int redblack, int ngrow) const
+{
+    BL_PROFILE("MLABecLaplacian::FsmoothDeep()");
+
+    const int amrlev = 0;
+    if (useSinglePrecision(mglev)) {
+        FsmoothT(amrlev, mglev, sol, rhs, redblack, m_a_coeffs_sp[amrlev][mglev],
+                 amrex::GetArrOfConstPtrs(m_b_coeffs_sp[amrlev][mglev]), true, ngrow);
+    } else {
+        FsmoothT<FArrayBox>(amrlev, mglev, sol, rhs, redblack, m_a_coeffs[amrlev][mglev],
+                            {AMREX_D_DECL(&m_b_coeffs[amrlev][mglev][0],
+                                          &m_b_coeffs[amrlev][mglev][1],
+                                          &m_b_coeffs[amrlev][mglev][2])},
+                            true, ngrow);
+    }
+}
+
+bool
+MLABecLaplacian::supportsDeepSmooth (int mglev) const
+{
+    const int amrlev = 0;
+    if (m_overset_mask[amrlev][mglev]) return false;
+    // line solve
+    if (mglev > 0 and mg_coarsen_ratio_vec[mglev-1] != mg_coarsen_ratio) return false;
+    // The coefficients are needed in the ghost cells the passes update.
+    return m_a_coeffs[amrlev][mglev].nGrow() >= info.smooth_ngrow-1;
+}
+
+template <typename FAB>
+void
+MLABecLaplacian::FsmoothT (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, int redblack,
+                           FabArray<FAB> const& acoef,
+                           Array<FabArray<FAB> const*,AMREX_SPACEDIM> const& bcoef,
+                           bool deep, int ngrow) const
+{
     bool regular_coarsening = true;
     if (amrlev == 0 and mglev > 0) {
         regular_coarsening = mg_coarsen_ratio_vec[mglev-1] == mg_coarsen_ratio;
     }
 
-    const MultiFab& acoef = m_a_coeffs[amrlev][mglev];
-    AMREX_D_TERM(const MultiFab& bxcoef = m_b_coeffs[amrlev][mglev][0];,
-                 const MultiFab& bycoef = m_b_coeffs[amrlev][mglev][1];,
-                 const MultiFab& bzcoef = m_b_coeffs[amrlev][mglev][2];);
-    const auto& undrrelxr = m_undrrelxr[amrlev][mglev];
-    const auto& maskvals  = m_maskvals [amrlev][mglev];
+    AMREX_D_TERM(FabArray<FAB> const& bxcoef = *bcoef[0];,
+                 FabArray<FAB> const& bycoef = *bcoef[1];,
+                 FabArray<FAB> const& bzcoef = *bcoef[2];);
+    const auto& undrrelxr = (deep) ? m_deep_undrrelxr[mglev] : m_undrrelxr[amrlev][mglev];
+    const auto& maskvals  = (deep) ? m_deep_maskvals[mglev]  : m_maskvals [amrlev][mglev];
 
     OrientationIter oitr;
 
@@ -529,8 +686,10 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
 #endif
 #endif
 
-	const Box& tbx = mfi.tilebox();
-        const Box& vbx = mfi.validbox();
+        // In a deep pass, the boxes grown by the ghost cells take the
+        // place of the valid boxes.
+        const Box& vbx = (deep) ? m_deep_grids[mglev][mfi.index()] : mfi.validbox();
+        const Box& tbx = (deep) ? mfi.growntilebox(ngrow) & vbx : mfi.tilebox();
         const auto& solnfab = sol.array(mfi);
         const auto& rhsfab  = rhs.array(mfi);
         const auto& afab    = acoef.array(mfi);
@@ -620,6 +779,17 @@ MLABecLaplacian::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab&
                              AMREX_D_DECL(f1fab,f3fab,f5fab),
                              osm, vbx, redblack, nc);
             });
+#if (AMREX_SPACEDIM > 1)
+        } else if (regular_coarsening && Gpu::notInLaunchRegion()) {
+            abec_gsrb_simd(tbx, solnfab, rhsfab, alpha, afab,
+                           AMREX_D_DECL(dhx, dhy, dhz),
+                           AMREX_D_DECL(bxfab, byfab, bzfab),
+                           AMREX_D_DECL(m0,m2,m4),
+                           AMREX_D_DECL(m1,m3,m5),
+                           AMREX_D_DECL(f0fab,f2fab,f4fab),
+                           AMREX_D_DECL(f1fab,f3fab,f5fab),
+                           vbx, redblack, nc);
+#endif
         } else if (regular_coarsening) {
             AMREX_LAUNCH_HOST_DEVICE_FUSIBLE_LAMBDA ( tbx, thread_box,
             {
@@ -774,6 +944,10 @@ MLABecLaplacian::update ()
         }
     }
 
+    if (!isTensorOp()) {
+        computeChebyshevBounds();
+    }
+
     m_needs_update = false;
 }
 
@@ -49,6 +49,44 @@ sxay (MultiFab&       ss,
     sxay(ss,xx,a,yy,0,nghost);
 }
 
+//
+// A sum or max over the bottom communicator of a few local values, started
+// with start() and finished with wait(), so that work can be done while the
+// reduction is in flight.
+//
+class NonblockingAllReduce
+{
+public:
+    void start (Real* v, int n, bool is_max, MPI_Comm comm)
+    {
+#ifdef BL_USE_MPI
+        BL_MPI_REQUIRE(MPI_Iallreduce(MPI_IN_PLACE, v, n,
+                                      ParallelDescriptor::Mpi_typemap<Real>::type(),
+                                      is_max ? MPI_MAX : MPI_SUM, comm, &m_req));
+#else
+        amrex::ignore_unused(v,n,is_max,comm);
+#endif
+        m_pending = true;
+    }
+
+    void wait ()
+    {
+        if (m_pending) {
+            BL_PROFILE("MLCGSolver::ParallelAllReduce");
+#ifdef BL_USE_MPI
+            BL_MPI_REQUIRE(MPI_Wait(&m_req, MPI_STATUS_IGNORE));
+#endif
+            m_pending = false;
+        }
+    }
+
+    bool pending () const noexcept { return m_pending; }
+
+private:
+    MPI_Request m_req = MPI_REQUEST_NULL;
+    bool m_pending = false;
+};
+
 }
 
 MLCGSolver::MLCGSolver (MLMG* a_mlmg, MLLinOp& _lp, Type _typ)
@@ -73,6 +111,10 @@ MLCGSolver::solve (MultiFab&       sol,
 {
     if (solver_type == Type::BiCGStab) {
         return solve_bicgstab(sol,rhs,eps_rel,eps_abs);
+    } else if (solver_type == Type::PipelinedBiCGStab) {
+        return solve_bicgstab_pipelined(sol,rhs,eps_rel,eps_abs);
+    } else if (solver_type == Type::PipelinedCG) {
+        return solve_cg_pipelined(sol,rhs,eps_rel,eps_abs);
     } else {
         return solve_cg(sol,rhs,eps_rel,eps_abs);
     }
@@ -396,6 +438,399 @@ MLCGSolver::solve_cg (MultiFab&       sol,
     return ret;
 }
 
+//
+// BiCGStab with merged reductions.  The dot products (rh,s) and (rh,t) are
+// reduced together with (t,t) and (t,s), which gives the next rho without
+// a reduction of its own, and the inf-norms of s and r used for the
+// convergence checks are reduced while the next operator apply is running.
+// This leaves two blocking reductions per iteration.
+//
+int
+MLCGSolver::solve_bicgstab_pipelined (MultiFab&       sol,
+                                      const MultiFab& rhs,
+                                      Real            eps_rel,
+                                      Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::bicgstab_pipelined");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    MultiFab ph(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    MultiFab sh(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    ph.setVal(0.0);
+    sh.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab p    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab rh   (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab v    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab t    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    Lp.normalize(amrlev, mglev, r);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+    MultiFab::Copy(rh,   r,  0,0,ncomp,nghost);
+
+    sol.setVal(0);
+
+    Real rnorm = norm_inf(r);
+    const Real rnorm0   = rnorm;
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_BiCGStab_Pipelined: Initial error (error0) =        " << rnorm0 << '\n';
+    }
+    int ret = 0;
+    iter = 1;
+    Real alpha = 0, omega = 0, rho_1 = 0;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 )
+        {
+            amrex::Print() << "MLCGSolver_BiCGStab_Pipelined: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    Real rho = dotxy(rh,r);
+
+    const MPI_Comm comm = Lp.BottomCommunicator();
+    NonblockingAllReduce rnorm_reduce;
+    Real rnorm_local = 0;
+
+    for (; iter <= maxiter; ++iter)
+    {
+        if ( rho == 0 )
+        {
+            ret = 1; break;
+        }
+        if ( iter == 1 )
+        {
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+        }
+        else
+        {
+            const Real beta = (rho/rho_1)*(alpha/omega);
+            sxay(p, p, -omega, v, nghost);
+            sxay(p, r,   beta, p, nghost);
+        }
+        MultiFab::Copy(ph,p,0,0,ncomp,nghost);
+        Lp.apply(amrlev, mglev, v, ph, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Lp.normalize(amrlev, mglev, v);
+
+        // The norm of the r of the last iteration has arrived.
+        if (rnorm_reduce.pending())
+        {
+            rnorm_reduce.wait();
+            rnorm = rnorm_local;
+
+            if ( verbose > 2 )
+            {
+                amrex::Print() << "MLCGSolver_BiCGStab_Pipelined: Iteration "
+                               << std::setw(11) << iter-1
+                               << " rel. err. "
+                               << rnorm/(rnorm0) << '\n';
+            }
+
+            if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) { --iter; break; }
+        }
+
+        Real rhTv = dotxy(rh,v);
+        if ( rhTv != Real(0.0) )
+        {
+            alpha = rho/rhTv;
+        }
+        else
+        {
+            ret = 2; break;
+        }
+        sxay(sol, sol,  alpha, ph, nghost);
+        sxay(s,     r, -alpha,  v, nghost);
+
+        Real snorm = norm_inf(s, true);
+        NonblockingAllReduce snorm_reduce;
+        snorm_reduce.start(&snorm, 1, true, comm);
+
+        MultiFab::Copy(sh,s,0,0,ncomp,nghost);
+        Lp.apply(amrlev, mglev, t, sh, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+        Lp.normalize(amrlev, mglev, t);
+
+        snorm_reduce.wait();
+        rnorm = snorm;
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_BiCGStab_Pipelined: Half Iter "
+                           << std::setw(11) << iter
+                           << " rel. err. "
+                           << rnorm/(rnorm0) << '\n';
+        }
+
+        if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) break;
+
+        Real tvals[4] = { dotxy(t,t,true), dotxy(t,s,true), dotxy(rh,s,true), dotxy(rh,t,true) };
+
+        BL_PROFILE_VAR("MLCGSolver::ParallelAllReduce", blp_par);
+        ParallelAllReduce::Sum(tvals,4,comm);
+        BL_PROFILE_VAR_STOP(blp_par);
+
+        if ( tvals[0] != Real(0.0) )
+        {
+            omega = tvals[1]/tvals[0];
+        }
+        else
+        {
+            ret = 3; break;
+        }
+        sxay(sol, sol,  omega, sh, nghost);
+        sxay(r,     s, -omega,  t, nghost);
+
+        rnorm_local = norm_inf(r, true);
+        rnorm_reduce.start(&rnorm_local, 1, true, comm);
+
+        if ( omega == 0 )
+        {
+            ret = 4; break;
+        }
+        rho_1 = rho;
+        rho = tvals[2] - omega*tvals[3]; // (rh,r) of the new r
+    }
+
+    if (rnorm_reduce.pending())
+    {
+        rnorm_reduce.wait();
+        rnorm = rnorm_local;
+        if (iter > maxiter) iter = maxiter;
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_BiCGStab_Pipelined: Final: Iteration "
+                       << std::setw(4) << iter
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+    }
+
+    if ( ret == 0 && rnorm > eps_rel*rnorm0 && rnorm > eps_abs)
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_BiCGStab_Pipelined:: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
+//
+// Pipelined CG of Ghysels and Vanroose.  The recurrences for s = A p,
+// w = A r and z = A s replace the apply of p, so that the reduction of
+// (r,r), (w,r) and the inf-norm of r overlaps with the apply of w.  The
+// convergence check therefore lags by one apply.
+//
+int
+MLCGSolver::solve_cg_pipelined (MultiFab&       sol,
+                                const MultiFab& rhs,
+                                Real            eps_rel,
+                                Real            eps_abs)
+{
+    BL_PROFILE("MLCGSolver::cg_pipelined");
+
+    const int ncomp = sol.nComp();
+
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    const auto& factory = sol.Factory();
+
+    MultiFab p(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    MultiFab w(ba, dm, ncomp, sol.nGrow(), MFInfo(), factory);
+    p.setVal(0.0);
+    w.setVal(0.0);
+
+    MultiFab sorig(ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab r    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab s    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab z    (ba, dm, ncomp, nghost, MFInfo(), factory);
+    MultiFab q    (ba, dm, ncomp, nghost, MFInfo(), factory);
+
+    MultiFab::Copy(sorig,sol,0,0,ncomp,nghost);
+
+    Lp.correctionResidual(amrlev, mglev, r, sol, rhs, MLLinOp::BCMode::Homogeneous);
+
+    sol.setVal(0);
+
+    Real       rnorm    = norm_inf(r);
+    const Real rnorm0   = rnorm;
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_CG_Pipelined: Initial error (error0) :        " << rnorm0 << '\n';
+    }
+
+    Real gamma_1 = 0, alpha_1 = 0;
+    int  ret = 0;
+    iter = 1;
+
+    if ( rnorm0 == 0 || rnorm0 < eps_abs )
+    {
+        if ( verbose > 0 ) {
+            amrex::Print() << "MLCGSolver_CG_Pipelined: niter = 0,"
+                           << ", rnorm = " << rnorm
+                           << ", eps_abs = " << eps_abs << std::endl;
+        }
+        return ret;
+    }
+
+    // w = A r, using p as the ghosted copy of r
+    MultiFab::Copy(p,r,0,0,ncomp,nghost);
+    Lp.apply(amrlev, mglev, w, p, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+
+    const MPI_Comm comm = Lp.BottomCommunicator();
+    bool converged = false;
+
+    for (; iter <= maxiter; ++iter)
+    {
+        Real dots[2] = { dotxy(r,r,true), dotxy(w,r,true) };
+        Real rnorm_local = norm_inf(r, true);
+        NonblockingAllReduce dot_reduce, rnorm_reduce;
+        dot_reduce.start(dots, 2, false, comm);
+        rnorm_reduce.start(&rnorm_local, 1, true, comm);
+
+        Lp.apply(amrlev, mglev, q, w, MLLinOp::BCMode::Homogeneous, MLLinOp::StateMode::Correction);
+
+        dot_reduce.wait();
+        rnorm_reduce.wait();
+
+        // The r of the last iteration
+        if (iter > 1)
+        {
+            rnorm = rnorm_local;
+
+            if ( verbose > 2 )
+            {
+                amrex::Print() << "MLCGSolver_cg_pipelined: Iteration"
+                               << std::setw(4) << iter-1
+                               << " rel. err. "
+                               << rnorm/(rnorm0) << '\n';
+            }
+
+            if ( rnorm < eps_rel*rnorm0 || rnorm < eps_abs ) {
+                converged = true;
+                --iter;
+                break;
+            }
+        }
+
+        const Real gamma = dots[0];
+        const Real delta = dots[1];
+        if ( gamma == 0 )
+        {
+            ret = 1; break;
+        }
+
+        Real alpha, beta;
+        if (iter == 1)
+        {
+            beta = 0;
+            if ( delta != Real(0.0) ) {
+                alpha = gamma/delta;
+            } else {
+                ret = 1; break;
+            }
+        }
+        else
+        {
+            beta = gamma/gamma_1;
+            const Real denom = delta - beta*gamma/alpha_1;
+            if ( denom != Real(0.0) ) {
+                alpha = gamma/denom;
+            } else {
+                ret = 1; break;
+            }
+        }
+
+        if ( verbose > 2 )
+        {
+            amrex::Print() << "MLCGSolver_cg_pipelined:"
+                           << " iter " << iter
+                           << " rho " << gamma
+                           << " alpha " << alpha << '\n';
+        }
+
+        if (iter == 1)
+        {
+            MultiFab::Copy(z,q,0,0,ncomp,nghost);
+            MultiFab::Copy(s,w,0,0,ncomp,nghost);
+            MultiFab::Copy(p,r,0,0,ncomp,nghost);
+        }
+        else
+        {
+            sxay(z, q, beta, z, nghost);
+            sxay(s, w, beta, s, nghost);
+            sxay(p, r, beta, p, nghost);
+        }
+        sxay(sol, sol, alpha, p, nghost);
+        sxay(  r,   r,-alpha, s, nghost);
+        sxay(  w,   w,-alpha, z, nghost);
+
+        gamma_1 = gamma;
+        alpha_1 = alpha;
+    }
+
+    if (ret == 0 && !converged)
+    {
+        iter = std::min(iter, maxiter);
+        rnorm = norm_inf(r);
+    }
+
+    if ( verbose > 0 )
+    {
+        amrex::Print() << "MLCGSolver_cg_pipelined: Final Iteration"
+                       << std::setw(4) << iter
+                       << " rel. err. "
+                       << rnorm/(rnorm0) << '\n';
+    }
+
+    if ( ret == 0 &&  rnorm > eps_rel*rnorm0 && rnorm > eps_abs )
+    {
+        if ( verbose > 0 && ParallelDescriptor::IOProcessor() )
+            amrex::Warning("MLCGSolver_cg_pipelined: failed to converge!");
+        ret = 8;
+    }
+
+    if ( ( ret == 0 || ret == 8 ) && (rnorm < rnorm0) )
+    {
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+    else
+    {
+        sol.setVal(0);
+        sol.plus(sorig, 0, ncomp, nghost);
+    }
+
+    return ret;
+}
+
 Real
 MLCGSolver::dotxy (const MultiFab& r, const MultiFab& z, bool local)
 {
@@ -145,6 +145,7 @@ MLCellLinOp::defineBC ()
     }
 
     m_bcondloc.resize(m_num_amr_levels);
+    m_bcondloc_frozen.resize(m_num_amr_levels, 0);
     for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
     {
         m_bcondloc[amrlev].resize(m_num_mg_levels[amrlev]);
@@ -219,6 +220,10 @@ MLCellLinOp::setLevelBC (int amrlev, const MultiFab* a_levelbcdata)
         br_ref_ratio = m_amr_ref_ratio[amrlev-1];
     }
 
+    // The boundary conditions of a frozen operator do not change, so
+    // only the boundary values need to be set again.
+    if (isFrozen() && m_bcondloc_frozen[amrlev]) return;
+
     m_bndry_sol[amrlev]->setLOBndryConds(m_lobc, m_hibc, br_ref_ratio, m_coarse_bc_loc);
 
     const Real* dx = m_geom[amrlev][0].CellSize();
@@ -229,6 +234,8 @@ MLCellLinOp::setLevelBC (int amrlev, const MultiFab* a_levelbcdata)
                                                    br_ref_ratio, m_coarse_bc_loc,
                                                    m_domain_bloc_lo, m_domain_bloc_hi);
     }
+
+    m_bcondloc_frozen[amrlev] = isFrozen();
 }
 
 BoxArray
@@ -348,18 +355,273 @@ MLCellLinOp::apply (int amrlev, int mglev, MultiFab& out, MultiFab& in, BCMode b
 
 void
 MLCellLinOp::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
-                     bool skip_fillboundary) const
+                     bool skip_fillboundary, int niter) const
 {
     BL_PROFILE("MLCellLinOp::smooth()");
-    for (int redblack = 0; redblack < 2; ++redblack)
+
+    if (useChebyshevSmoother()) {
+        chebyshevSmooth(amrlev, mglev, sol, rhs, niter);
+        return;
+    }
+
+    const int ngdeep = getSmoothNGrow(amrlev, mglev);
+    if (ngdeep > 1 && sol.nGrow() >= ngdeep) {
+        smoothDeep(mglev, sol, rhs, skip_fillboundary, niter);
+        return;
+    }
+
+    for (int i = 0; i < niter; ++i) {
+        for (int redblack = 0; redblack < 2; ++redblack)
+        {
+            applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution,
+                    nullptr, skip_fillboundary);
+#ifdef AMREX_SOFT_PERF_COUNTERS
+            perf_counters.smooth(sol);
+#endif
+            Fsmooth(amrlev, mglev, sol, rhs, redblack);
+            skip_fillboundary = false;
+        }
+    }
+}
+
+void
+MLCellLinOp::smoothDeep (int mglev, MultiFab& sol, const MultiFab& rhs,
+                         bool skip_fillboundary, int niter) const
+{
+    BL_PROFILE("MLCellLinOp::smoothDeep()");
+
+    const int ncomp = getNComp();
+    const int ngrow = m_deep_smooth[mglev];
+    const Periodicity period = m_geom[0][mglev].periodicity();
+
+    // The passes over the ghost cells need the rhs there too.
+    MultiFab& drhs = m_deep_rhs[mglev];
+    if (!drhs.ok()) {
+        drhs.define(m_grids[0][mglev], m_dmap[0][mglev], ncomp, ngrow-1,
+                    MFInfo(), *m_factory[0][mglev]);
+    }
+    MultiFab::Copy(drhs, rhs, 0, 0, ncomp, 0);
     {
-        applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution,
-                nullptr, skip_fillboundary);
+        MLPerfStats::Timer perf(m_perf_stats, MLPerfStats::fillboundary, 0, mglev);
+        perf.addFillBoundaryBytes(drhs, ncomp, IntVect(ngrow-1), period, false);
+        drhs.FillBoundary_nowait(0, ncomp, IntVect(ngrow-1), period);
+    }
+
+    // Number of ghost cells in sol that are up to date
+    int nvalid = skip_fillboundary ? ngrow : 0;
+    for (int pass = 0; pass < 2*niter; ++pass)
+    {
+        if (nvalid == 0 || pass == 0)
+        {
+            MLPerfStats::Timer perf(m_perf_stats, MLPerfStats::fillboundary, 0, mglev);
+            if (nvalid == 0) {
+                perf.addFillBoundaryBytes(sol, ncomp, IntVect(ngrow), period, false);
+                sol.FillBoundary_nowait(0, ncomp, IntVect(ngrow), period);
+            }
+            if (pass == 0) {
+                drhs.FillBoundary_finish();
+            }
+            if (nvalid == 0) {
+                sol.FillBoundary_finish();
+                nvalid = ngrow;
+            }
+        }
+
+        applyDeepBC(mglev, sol);
 #ifdef AMREX_SOFT_PERF_COUNTERS
         perf_counters.smooth(sol);
 #endif
-        Fsmooth(amrlev, mglev, sol, rhs, redblack);
-        skip_fillboundary = false;
+        FsmoothDeep(mglev, sol, drhs, pass%2, nvalid-1);
+        --nvalid;
+    }
+}
+
+void
+MLCellLinOp::applyDeepBC (int mglev, MultiFab& sol) const
+{
+    const int ncomp = getNComp();
+    const int imaxorder = maxorder;
+    const int flagbc = 0;
+
+    const Real* dxinv = m_geom[0][mglev].InvCellSize();
+    const Real dxi = dxinv[0];
+    const Real dyi = (AMREX_SPACEDIM >= 2) ? dxinv[1] : 1.0;
+    const Real dzi = (AMREX_SPACEDIM == 3) ? dxinv[2] : 1.0;
+
+    const auto& maskvals = m_deep_maskvals[mglev];
+    const auto& bcondloc = *m_deep_bcondloc[mglev];
+    const BoxArray& dba = m_deep_grids[mglev];
+
+    FArrayBox foofab(Box::TheUnitBox(),ncomp);
+    const auto& foo = foofab.const_array();
+
+    MFItInfo mfi_info;
+    if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
+
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+    for (MFIter mfi(sol, mfi_info); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = dba[mfi.index()];
+        const auto& iofab = sol.array(mfi);
+
+        const auto & bdlv = bcondloc.bndryLocs(mfi);
+        const auto & bdcv = bcondloc.bndryConds(mfi);
+
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            const Orientation olo(idim,Orientation::low);
+            const Orientation ohi(idim,Orientation::high);
+            const Box blo = amrex::adjCellLo(vbx, idim);
+            const Box bhi = amrex::adjCellHi(vbx, idim);
+            const int blen = vbx.length(idim);
+            const auto& mlo = maskvals[olo].array(mfi);
+            const auto& mhi = maskvals[ohi].array(mfi);
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                const BoundCond bctlo = bdcv[icomp][olo];
+                const BoundCond bcthi = bdcv[icomp][ohi];
+                const Real bcllo = bdlv[icomp][olo];
+                const Real bclhi = bdlv[icomp][ohi];
+                if (idim == 0) {
+                    AMREX_LAUNCH_HOST_DEVICE_FUSIBLE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_x(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dxi, flagbc, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_x(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dxi, flagbc, icomp);
+                    });
+                } else if (idim == 1) {
+                    AMREX_LAUNCH_HOST_DEVICE_FUSIBLE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_y(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dyi, flagbc, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_y(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dyi, flagbc, icomp);
+                    });
+                } else {
+                    AMREX_LAUNCH_HOST_DEVICE_FUSIBLE_LAMBDA (
+                    blo, tboxlo, {
+                    mllinop_apply_bc_z(0, tboxlo, blen, iofab, mlo,
+                                       bctlo, bcllo, foo,
+                                       imaxorder, dzi, flagbc, icomp);
+                    },
+                    bhi, tboxhi, {
+                    mllinop_apply_bc_z(1, tboxhi, blen, iofab, mhi,
+                                       bcthi, bclhi, foo,
+                                       imaxorder, dzi, flagbc, icomp);
+                    });
+                }
+            }
+        }
+    }
+}
+
+int
+MLCellLinOp::getSmoothNGrow (int amrlev, int mglev) const
+{
+    if (useChebyshevSmoother()) return 0;
+    return (amrlev == 0 && mglev < m_deep_smooth.size()) ? m_deep_smooth[mglev] : 0;
+}
+
+void
+MLCellLinOp::FsmoothDeep (int /*mglev*/, MultiFab& /*sol*/, const MultiFab& /*rhs*/,
+                          int /*redblack*/, int /*ngrow*/) const
+{
+    amrex::Abort("MLCellLinOp::FsmoothDeep: not supported by this operator");
+}
+
+void
+MLCellLinOp::defineDeepSmooth ()
+{
+    BL_PROFILE("MLCellLinOp::defineDeepSmooth()");
+
+    const int amrlev = 0;
+    const int nmglevs = m_num_mg_levels[amrlev];
+    const int ngrow = info.smooth_ngrow;
+    const int ncomp = getNComp();
+
+    m_deep_smooth.clear();
+    m_deep_smooth.resize(nmglevs, 0);
+    m_deep_grids.clear();
+    m_deep_grids.resize(nmglevs);
+    m_deep_maskvals.clear();
+    m_deep_maskvals.resize(nmglevs);
+    m_deep_bcondloc.clear();
+    m_deep_bcondloc.resize(nmglevs);
+    m_deep_undrrelxr.clear();
+    m_deep_undrrelxr.resize(nmglevs);
+    m_deep_rhs.clear();
+    m_deep_rhs.resize(nmglevs);
+
+    if (ngrow < 2 || !isCrossStencil()) return;
+
+    // The ghost region is only filled by the physical bc if the grids of
+    // AMR level 0 cover the domain.  Otherwise, e.g., in a level solve
+    // with a coarse/fine bc, it reaches uncovered cells.
+    if (!m_domain_covered[0] || needsCoarseDataForBC()) return;
+
+    for (int mglev = 0; mglev < nmglevs; ++mglev)
+    {
+        if (!supportsDeepSmooth(mglev)) continue;
+
+        const Geometry& geom = m_geom[amrlev][mglev];
+        const Box& domain = geom.Domain();
+        const BoxArray& ba = m_grids[amrlev][mglev];
+        const DistributionMapping& dm = m_dmap[amrlev][mglev];
+
+        // The red-black coloring has to agree across periodic boundaries,
+        // and the order of the bc extrapolation, which depends on the
+        // box length, has to agree between a box and the ghost cells of
+        // its neighbors.
+        bool ok = true;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (geom.isPeriodic(idim) &&
+                (domain.length(idim)%2 != 0 || domain.length(idim) < ngrow)) {
+                ok = false;
+            }
+        }
+        for (int i = 0, N = ba.size(); i < N && ok; ++i) {
+            if (ba[i].shortside() < maxorder-1) ok = false;
+        }
+        if (!ok) continue;
+
+        Box clip = domain;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            if (geom.isPeriodic(idim)) clip.grow(idim, ngrow);
+        }
+        BoxList bl;
+        bl.reserve(ba.size());
+        for (int i = 0, N = ba.size(); i < N; ++i) {
+            bl.push_back(amrex::grow(ba[i],ngrow) & clip);
+        }
+        m_deep_grids[mglev] = BoxArray(std::move(bl));
+        const BoxArray& dba = m_deep_grids[mglev];
+
+        for (OrientationIter oitr; oitr; ++oitr)
+        {
+            const Orientation face = oitr();
+            m_deep_maskvals[mglev][face].define(dba, dm, geom, face, 0, 1, 0, 1, true);
+        }
+
+        m_deep_bcondloc[mglev].reset(new BndryCondLoc(dba, dm, ncomp));
+        m_deep_bcondloc[mglev]->setLOBndryConds(geom, m_geom[amrlev][0].CellSize(),
+                                                m_lobc, m_hibc, 1, m_coarse_bc_loc,
+                                                m_domain_bloc_lo, m_domain_bloc_hi);
+
+        m_deep_undrrelxr[mglev].define(dba, dm, 1, 0, 0, ncomp);
+        compInterpCoef0(amrlev, mglev, dba, m_deep_maskvals[mglev], *m_deep_bcondloc[mglev],
+                        m_deep_undrrelxr[mglev], false);
+
+        m_deep_smooth[mglev] = ngrow;
     }
 }
 
@@ -452,6 +714,8 @@ MLCellLinOp::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
     const int cross = isCrossStencil();
     const int tensorop = isTensorOp();
     if (!skip_fillboundary) {
+        MLPerfStats::Timer perf(m_perf_stats, MLPerfStats::fillboundary, amrlev, mglev);
+        perf.addFillBoundaryBytes(in, ncomp, in.nGrowVect(), m_geom[amrlev][mglev].periodicity(), cross);
         in.FillBoundary(0, ncomp, m_geom[amrlev][mglev].periodicity(),cross);
     }
 
@@ -750,144 +1014,155 @@ MLCellLinOp::prepareForSolve ()
 {
     BL_PROFILE("MLCellLinOp::prepareForSolve()");
 
-    const int imaxorder = maxorder;
-    const int ncomp = getNComp();
     for (int amrlev = 0;  amrlev < m_num_amr_levels; ++amrlev)
     {
         for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev)
         {
-            const auto& bcondloc = *m_bcondloc[amrlev][mglev];
-            const auto& maskvals = m_maskvals[amrlev][mglev];
+            compInterpCoef0(amrlev, mglev, m_grids[amrlev][mglev], m_maskvals[amrlev][mglev],
+                            *m_bcondloc[amrlev][mglev], m_undrrelxr[amrlev][mglev], true);
+        }
+    }
 
-            const Real dxi = m_geom[amrlev][mglev].InvCellSize(0);
-            const Real dyi = (AMREX_SPACEDIM >= 2) ? m_geom[amrlev][mglev].InvCellSize(1) : 1.0;
-            const Real dzi = (AMREX_SPACEDIM == 3) ? m_geom[amrlev][mglev].InvCellSize(2) : 1.0;
+    defineDeepSmooth();
+}
 
-            BndryRegister& undrrelxr = m_undrrelxr[amrlev][mglev];
-            MultiFab foo(m_grids[amrlev][mglev], m_dmap[amrlev][mglev], ncomp, 0, MFInfo().SetAlloc(false));
+void
+MLCellLinOp::compInterpCoef0 (int amrlev, int mglev, const BoxArray& ba,
+                              const Array<MultiMask,2*AMREX_SPACEDIM>& maskvals,
+                              const BndryCondLoc& bcondloc, BndryRegister& undrrelxr,
+                              bool use_eb) const
+{
+    const int imaxorder = maxorder;
+    const int ncomp = getNComp();
+    const Real dxi = m_geom[amrlev][mglev].InvCellSize(0);
+    const Real dyi = (AMREX_SPACEDIM >= 2) ? m_geom[amrlev][mglev].InvCellSize(1) : 1.0;
+    const Real dzi = (AMREX_SPACEDIM == 3) ? m_geom[amrlev][mglev].InvCellSize(2) : 1.0;
+
+    MultiFab foo(ba, m_dmap[amrlev][mglev], ncomp, 0, MFInfo().SetAlloc(false));
 
 #ifdef AMREX_USE_EB
-            auto factory = dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get());
-            const FabArray<EBCellFlagFab>* flags =
-                (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
-            auto area = (factory) ? factory->getAreaFrac()
-                : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+    auto factory = (use_eb) ? dynamic_cast<EBFArrayBoxFactory const*>(m_factory[amrlev][mglev].get())
+                            : nullptr;
+    const FabArray<EBCellFlagFab>* flags =
+        (factory) ? &(factory->getMultiEBCellFlagFab()) : nullptr;
+    auto area = (factory) ? factory->getAreaFrac()
+        : Array<const MultiCutFab*,AMREX_SPACEDIM>{AMREX_D_DECL(nullptr,nullptr,nullptr)};
+#else
+    amrex::ignore_unused(use_eb);
 #endif
 
-            MFItInfo mfi_info;
-            if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
+    MFItInfo mfi_info;
+    if (Gpu::notInLaunchRegion()) mfi_info.SetDynamic(true);
 
 #ifdef _OPENMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
-            for (MFIter mfi(foo, mfi_info); mfi.isValid(); ++mfi)
-            {
-                const Box& vbx = mfi.validbox();
+    for (MFIter mfi(foo, mfi_info); mfi.isValid(); ++mfi)
+    {
+        const Box& vbx = mfi.validbox();
 
-                const auto & bdlv = bcondloc.bndryLocs(mfi);
-                const auto & bdcv = bcondloc.bndryConds(mfi);
+        const auto & bdlv = bcondloc.bndryLocs(mfi);
+        const auto & bdcv = bcondloc.bndryConds(mfi);
 
 #ifdef AMREX_USE_EB
-                auto fabtyp = (flags) ? (*flags)[mfi].getType(vbx) : FabType::regular;
+        auto fabtyp = (flags) ? (*flags)[mfi].getType(vbx) : FabType::regular;
 #endif
 
-                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
-                {
-                    const Orientation olo(idim,Orientation::low);
-                    const Orientation ohi(idim,Orientation::high);
-                    const Box blo = amrex::adjCellLo(vbx, idim);
-                    const Box bhi = amrex::adjCellHi(vbx, idim);
-                    const int blen = vbx.length(idim);
-                    const auto& mlo = maskvals[olo].array(mfi);
-                    const auto& mhi = maskvals[ohi].array(mfi);
-                    const auto& flo = undrrelxr[olo].array(mfi);
-                    const auto& fhi = undrrelxr[ohi].array(mfi);
-                    for (int icomp = 0; icomp < ncomp; ++icomp) {
-                        const BoundCond bctlo = bdcv[icomp][olo];
-                        const BoundCond bcthi = bdcv[icomp][ohi];
-                        const Real bcllo = bdlv[icomp][olo];
-                        const Real bclhi = bdlv[icomp][ohi];
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim)
+        {
+            const Orientation olo(idim,Orientation::low);
+            const Orientation ohi(idim,Orientation::high);
+            const Box blo = amrex::adjCellLo(vbx, idim);
+            const Box bhi = amrex::adjCellHi(vbx, idim);
+            const int blen = vbx.length(idim);
+            const auto& mlo = maskvals[olo].array(mfi);
+            const auto& mhi = maskvals[ohi].array(mfi);
+            const auto& flo = undrrelxr[olo].array(mfi);
+            const auto& fhi = undrrelxr[ohi].array(mfi);
+            for (int icomp = 0; icomp < ncomp; ++icomp) {
+                const BoundCond bctlo = bdcv[icomp][olo];
+                const BoundCond bcthi = bdcv[icomp][ohi];
+                const Real bcllo = bdlv[icomp][olo];
+                const Real bclhi = bdlv[icomp][ohi];
 #ifdef AMREX_USE_EB
-                        if (fabtyp == FabType::singlevalued) {
-                            Array4<Real const> const& ap = area[idim]->const_array(mfi);
-                            if (idim == 0) {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_x_eb
-                                    (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
-                                     imaxorder, dxi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_x_eb
-                                    (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
-                                     imaxorder, dxi, icomp);
-                                });
-                            } else if (idim == 1) {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_y_eb
-                                    (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
-                                     imaxorder, dyi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_y_eb
-                                    (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
-                                     imaxorder, dyi, icomp);
-                                });
-                            } else {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_z_eb
-                                    (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
-                                     imaxorder, dzi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_z_eb
-                                    (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
-                                     imaxorder, dzi, icomp);
-                                });
-                            }
-                        } else
+                if (fabtyp == FabType::singlevalued) {
+                    Array4<Real const> const& ap = area[idim]->const_array(mfi);
+                    if (idim == 0) {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_x_eb
+                            (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
+                             imaxorder, dxi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_x_eb
+                            (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
+                             imaxorder, dxi, icomp);
+                        });
+                    } else if (idim == 1) {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_y_eb
+                            (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
+                             imaxorder, dyi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_y_eb
+                            (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
+                             imaxorder, dyi, icomp);
+                        });
+                    } else {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_z_eb
+                            (0, tboxlo, blen, flo, mlo, ap, bctlo, bcllo,
+                             imaxorder, dzi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_z_eb
+                            (1, tboxhi, blen, fhi, mhi, ap, bcthi, bclhi,
+                             imaxorder, dzi, icomp);
+                        });
+                    }
+                } else
 #endif
-                        {
-                            if (idim == 0) {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_x
-                                    (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
-                                     imaxorder, dxi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_x
-                                    (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
-                                     imaxorder, dxi, icomp);
-                                });
-                            } else if (idim == 1) {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_y
-                                    (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
-                                     imaxorder, dyi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_y
-                                    (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
-                                     imaxorder, dyi, icomp);
-                                });
-                            } else {
-                                AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
-                                blo, tboxlo, {
-                                mllinop_comp_interp_coef0_z
-                                    (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
-                                     imaxorder, dzi, icomp);
-                                },
-                                bhi, tboxhi, {
-                                mllinop_comp_interp_coef0_z
-                                    (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
-                                     imaxorder, dzi, icomp);
-                                });
-                            }
-                        }
+                {
+                    if (idim == 0) {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_x
+                            (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
+                             imaxorder, dxi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_x
+                            (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
+                             imaxorder, dxi, icomp);
+                        });
+                    } else if (idim == 1) {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_y
+                            (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
+                             imaxorder, dyi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_y
+                            (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
+                             imaxorder, dyi, icomp);
+                        });
+                    } else {
+                        AMREX_LAUNCH_HOST_DEVICE_LAMBDA (
+                        blo, tboxlo, {
+                        mllinop_comp_interp_coef0_z
+                            (0, tboxlo, blen, flo, mlo, bctlo, bcllo,
+                             imaxorder, dzi, icomp);
+                        },
+                        bhi, tboxhi, {
+                        mllinop_comp_interp_coef0_z
+                            (1, tboxhi, blen, fhi, mhi, bcthi, bclhi,
+                             imaxorder, dzi, icomp);
+                        });
                     }
                 }
             }
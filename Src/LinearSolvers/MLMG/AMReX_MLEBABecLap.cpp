@@ -1477,6 +1477,8 @@ MLEBABecLap::applyBC (int amrlev, int mglev, MultiFab& in, BCMode bc_mode, State
     const int ncomp = getNComp();
     if (!skip_fillboundary) {
         const int cross = false;
+        MLPerfStats::Timer perf(m_perf_stats, MLPerfStats::fillboundary, amrlev, mglev);
+        perf.addFillBoundaryBytes(in, ncomp, in.nGrowVect(), m_geom[amrlev][mglev].periodicity(), cross);
         in.FillBoundary(0, ncomp, m_geom[amrlev][mglev].periodicity(),cross);
     }
 
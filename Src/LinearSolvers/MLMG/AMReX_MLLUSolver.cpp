@@ -0,0 +1,370 @@
+
+#include <AMReX_MLLUSolver.H>
+#include <AMReX_ParallelReduce.H>
+
+#include <algorithm>
+#include <cmath>
+
+namespace amrex {
+
+MLLUSolver::MLLUSolver (MLLinOp& a_lp)
+    : Lp(a_lp),
+      amrlev(0),
+      mglev(a_lp.NMGLevels(0)-1)
+{
+}
+
+MLLUSolver::~MLLUSolver ()
+{
+}
+
+Long
+MLLUSolver::pointIndex (IntVect const& iv) const noexcept
+{
+    Long r = 0;
+    Long stride = 1;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const int len = m_len[idim];
+        int i = iv[idim] - m_domain.smallEnd(idim);
+        if (m_periodic[idim]) {
+            i = ((i % len) + len) % len;
+        } else if (i < 0 || i >= len) {
+            return -1;
+        }
+        r += i*stride;
+        stride *= len;
+    }
+    return r;
+}
+
+Long
+MLLUSolver::estimateEntries (const MLLinOp& lp)
+{
+    const Geometry& geom = lp.Geom(0, lp.NMGLevels(0)-1);
+    const IndexType typ = lp.isCellCentered() ? IndexType::TheCellType() : IndexType::TheNodeType();
+    const Box domain = amrex::convert(geom.Domain(), typ);
+    Long npts = 1;
+    Long plane = 1;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        const Long len = geom.isPeriodic(idim) ? geom.Domain().length(idim) : domain.length(idim);
+        npts *= len;
+        if (idim < AMREX_SPACEDIM-1) { plane *= len; }
+    }
+    // With lexicographic numbering every row reaches at most one plane
+    // (plus a line and a point) back; periodic wrapping in the last
+    // direction can double that.
+    const Long ncomp = lp.getNComp();
+    Long width = ncomp * (plane + (AMREX_SPACEDIM > 1 ? domain.length(0) : 0) + 1);
+    if (geom.isPeriodic(AMREX_SPACEDIM-1)) { width *= 2; }
+    return 2 * npts * ncomp * width;
+}
+
+void
+MLLUSolver::define (const MultiFab& mf)
+{
+    BL_PROFILE("MLLUSolver::define()");
+
+    Gpu::LaunchSafeGuard lsg(false); // xxxxx TODO: gpu
+
+    const Real t0 = amrex::second();
+
+    const int ncomp = Lp.getNComp();
+    m_ncomp = ncomp;
+
+    const Geometry& geom = Lp.Geom(amrlev, mglev);
+    m_domain = amrex::convert(geom.Domain(), mf.ixType());
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        m_periodic[idim] = geom.isPeriodic(idim);
+        // The last node in a periodic direction is the same as the first.
+        m_len[idim] = m_periodic[idim] ? geom.Domain().length(idim) : m_domain.length(idim);
+        // Points within one cell of each other must have different colors.
+        m_ncolors[idim] = (m_periodic[idim] && m_len[idim] % 3 != 0) ? m_len[idim] : 3;
+    }
+
+    auto color_of = [&] (IntVect const& iv) -> IntVect {
+        IntVect c;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            const int len = m_len[idim];
+            const int i = (((iv[idim] - m_domain.smallEnd(idim)) % len) + len) % len;
+            c[idim] = i % m_ncolors[idim];
+        }
+        return c;
+    };
+
+    //
+    // Number the points covered by the grids in lexicographic order, which
+    // keeps the envelope of the matrix narrow.
+    //
+    const Long npts = AMREX_D_TERM(Long(m_len[0]), *m_len[1], *m_len[2]);
+    m_row.assign(npts, -1);
+    const BoxArray& ba = mf.boxArray();
+    for (int ibox = 0, nboxes = ba.size(); ibox < nboxes; ++ibox) {
+        amrex::LoopOnCpu(ba[ibox], [&] (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            m_row[pointIndex(IntVect(AMREX_D_DECL(i,j,k)))] = 0;
+        });
+    }
+    Long npoints = 0;
+    for (auto& r : m_row) {
+        if (r >= 0) r = npoints++;
+    }
+    m_nrows = npoints*ncomp;
+
+    const Box nbrbox(IntVect(-1), IntVect(1));
+    const int nnbrs = nbrbox.numPts();
+    const int nslots = nnbrs*ncomp;
+
+    // Row block of the neighbors of every point
+    Vector<Long> nbr(npoints*nnbrs, -1);
+    amrex::LoopOnCpu(Box(m_domain.smallEnd(), m_domain.smallEnd()+m_len-1, m_domain.ixType()),
+    [&] (int i, int j, int k) noexcept
+    {
+        amrex::ignore_unused(j,k);
+        const IntVect iv(AMREX_D_DECL(i,j,k));
+        const Long r = m_row[pointIndex(iv)];
+        if (r < 0) return;
+        amrex::LoopOnCpu(nbrbox, [&] (int ii, int jj, int kk) noexcept
+        {
+            amrex::ignore_unused(jj,kk);
+            const IntVect o(AMREX_D_DECL(ii,jj,kk));
+            const Long p = pointIndex(iv+o);
+            if (p >= 0) {
+                nbr[r*nnbrs+nbrbox.index(o)] = m_row[p];
+            }
+        });
+    });
+
+    MPI_Comm comm = ParallelContext::CommunicatorSub();
+
+    MultiFab xp(ba, mf.DistributionMap(), ncomp, 1, MFInfo(), *Lp.Factory(amrlev,mglev));
+    MultiFab yp(ba, mf.DistributionMap(), ncomp, 0, MFInfo(), *Lp.Factory(amrlev,mglev));
+
+    m_copies.assign(npoints, 0);
+    for (MFIter mfi(yp); mfi.isValid(); ++mfi) {
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            amrex::ignore_unused(j,k);
+            ++m_copies[m_row[pointIndex(IntVect(AMREX_D_DECL(i,j,k)))]];
+        });
+    }
+    ParallelAllReduce::Sum(m_copies.data(), m_copies.size(), comm);
+
+    //
+    // A unit vector on all points of one color and component gives, at
+    // every point, the entry of its row in the column of the only
+    // neighbor with that color.
+    //
+    Vector<Real> a(m_nrows*nslots, 0.0);
+    const Box colorbox(IntVect(0), m_ncolors-1);
+    for (int n = 0; n < ncomp; ++n) {
+        amrex::LoopOnCpu(colorbox, [&] (int ci, int cj, int ck)
+        {
+            amrex::ignore_unused(cj,ck);
+            const IntVect c(AMREX_D_DECL(ci,cj,ck));
+
+            xp.setVal(0.0);
+            for (MFIter mfi(xp); mfi.isValid(); ++mfi) {
+                Array4<Real> const& x = xp.array(mfi);
+                amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+                {
+                    if (color_of(IntVect(AMREX_D_DECL(i,j,k))) == c) {
+                        x(i,j,k,n) = 1.0;
+                    }
+                });
+            }
+
+            Lp.apply(amrlev, mglev, yp, xp, MLLinOp::BCMode::Homogeneous,
+                     MLLinOp::StateMode::Solution);
+
+            for (MFIter mfi(yp); mfi.isValid(); ++mfi) {
+                Array4<Real const> const& y = yp.const_array(mfi);
+                amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+                {
+                    const IntVect iv(AMREX_D_DECL(i,j,k));
+                    const Long r = m_row[pointIndex(iv)];
+                    for (int inbr = 0; inbr < nnbrs; ++inbr) {
+                        const IntVect o = nbrbox.atOffset(inbr);
+                        if (nbr[r*nnbrs+inbr] >= 0 && color_of(iv+o) == c) {
+                            for (int m = 0; m < ncomp; ++m) {
+                                a[(r*ncomp+m)*nslots+inbr*ncomp+n] += y(i,j,k,m);
+                            }
+                            break;
+                        }
+                    }
+                });
+            }
+        });
+    }
+
+    ParallelAllReduce::Sum(a.data(), a.size(), comm);
+    for (Long r = 0; r < npoints; ++r) {
+        for (int islot = 0; islot < ncomp*nslots; ++islot) {
+            a[r*ncomp*nslots+islot] /= m_copies[r];
+        }
+    }
+
+    //
+    // Envelope of the matrix.  The factors of an LU decomposition without
+    // pivoting fit into it.
+    //
+    m_first.resize(m_nrows);
+    for (Long row = 0; row < m_nrows; ++row) {
+        m_first[row] = row;
+    }
+    for (Long r = 0; r < npoints; ++r) {
+        for (int m = 0; m < ncomp; ++m) {
+            const Long row = r*ncomp+m;
+            for (int inbr = 0; inbr < nnbrs; ++inbr) {
+                for (int n = 0; n < ncomp; ++n) {
+                    if (a[row*nslots+inbr*ncomp+n] != 0.0) {
+                        const Long col = nbr[r*nnbrs+inbr]*ncomp+n;
+                        m_first[row] = std::min(m_first[row], col);
+                        m_first[col] = std::min(m_first[col], row);
+                    }
+                }
+            }
+        }
+    }
+
+    m_lo_offset.resize(m_nrows+1);
+    m_up_offset.resize(m_nrows+1);
+    m_lo_offset[0] = 0;
+    m_up_offset[0] = 0;
+    for (Long row = 0; row < m_nrows; ++row) {
+        m_lo_offset[row+1] = m_lo_offset[row] + (row - m_first[row]);
+        m_up_offset[row+1] = m_up_offset[row] + (row - m_first[row] + 1);
+    }
+    m_lo.assign(m_lo_offset[m_nrows], 0.0);
+    m_up.assign(m_up_offset[m_nrows], 0.0);
+
+    // Row i of L and column i of U are stored from m_first[i] on.
+    for (Long r = 0; r < npoints; ++r) {
+        for (int m = 0; m < ncomp; ++m) {
+            const Long row = r*ncomp+m;
+            for (int inbr = 0; inbr < nnbrs; ++inbr) {
+                if (nbr[r*nnbrs+inbr] < 0) continue;
+                for (int n = 0; n < ncomp; ++n) {
+                    const Long col = nbr[r*nnbrs+inbr]*ncomp+n;
+                    const Real v = a[row*nslots+inbr*ncomp+n];
+                    if (col < row) {
+                        m_lo[m_lo_offset[row]+col-m_first[row]] += v;
+                    } else {
+                        m_up[m_up_offset[col]+row-m_first[col]] += v;
+                    }
+                }
+            }
+        }
+    }
+
+    factorize();
+
+    if (verbose > 0) {
+        amrex::Print() << "MLLUSolver: " << m_nrows << " unknowns, "
+                       << numEntries() << " entries in the factors, setup time "
+                       << amrex::second()-t0 << "\n";
+    }
+}
+
+void
+MLLUSolver::factorize ()
+{
+    BL_PROFILE("MLLUSolver::factorize()");
+
+    const Long N = m_nrows;
+    for (Long j = 0; j < N; ++j)
+    {
+        const Long fj = m_first[j];
+        Real* lj = m_lo.data() + m_lo_offset[j] - fj;  // lj[m] = L(j,m)
+        Real* uj = m_up.data() + m_up_offset[j] - fj;  // uj[m] = U(m,j)
+
+        // Row j of L
+        for (Long i = fj; i < j; ++i) {
+            const Long fi = m_first[i];
+            const Real* ui = m_up.data() + m_up_offset[i] - fi;
+            Real s = lj[i];
+            for (Long m = std::max(fi,fj); m < i; ++m) {
+                s -= lj[m]*ui[m];
+            }
+            lj[i] = s / ui[i];
+        }
+
+        // Column j of U
+        const Real ajj = uj[j];
+        for (Long i = fj; i <= j; ++i) {
+            const Long fi = m_first[i];
+            const Real* li = m_lo.data() + m_lo_offset[i] - fi;
+            Real s = uj[i];
+            for (Long m = std::max(fi,fj); m < i; ++m) {
+                s -= li[m]*uj[m];
+            }
+            uj[i] = s;
+        }
+
+        // A vanishing pivot means that the matrix is singular (e.g., pure
+        // Neumann or periodic, where the right-hand side has been made
+        // solvable) or that the row is empty (e.g., Dirichlet nodes).  Any
+        // value of the unknown will then do.
+        if (std::abs(uj[j]) <= Real(1.e-12)*std::abs(ajj)) {
+            uj[j] = (ajj != Real(0.0)) ? ajj : Real(1.0);
+        }
+    }
+}
+
+void
+MLLUSolver::solve (MultiFab& solnL, const MultiFab& rhsL) const
+{
+    BL_PROFILE("MLLUSolver::solve()");
+
+    Gpu::LaunchSafeGuard lsg(false); // xxxxx TODO: gpu
+
+    const int ncomp = m_ncomp;
+    const Long N = m_nrows;
+
+    Vector<Real> y(N, 0.0);
+    for (MFIter mfi(rhsL); mfi.isValid(); ++mfi) {
+        Array4<Real const> const& b = rhsL.const_array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            const Long r = m_row[pointIndex(IntVect(AMREX_D_DECL(i,j,k)))];
+            for (int n = 0; n < ncomp; ++n) {
+                y[r*ncomp+n] += b(i,j,k,n) / m_copies[r];
+            }
+        });
+    }
+    ParallelAllReduce::Sum(y.data(), y.size(), ParallelContext::CommunicatorSub());
+
+    // L has a unit diagonal.
+    for (Long i = 0; i < N; ++i) {
+        const Long fi = m_first[i];
+        const Real* li = m_lo.data() + m_lo_offset[i] - fi;
+        Real s = y[i];
+        for (Long m = fi; m < i; ++m) {
+            s -= li[m]*y[m];
+        }
+        y[i] = s;
+    }
+
+    for (Long j = N-1; j >= 0; --j) {
+        const Long fj = m_first[j];
+        const Real* uj = m_up.data() + m_up_offset[j] - fj;
+        y[j] /= uj[j];
+        const Real yj = y[j];
+        for (Long i = fj; i < j; ++i) {
+            y[i] -= uj[i]*yj;
+        }
+    }
+
+    for (MFIter mfi(solnL); mfi.isValid(); ++mfi) {
+        Array4<Real> const& x = solnL.array(mfi);
+        amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k) noexcept
+        {
+            const Long r = m_row[pointIndex(IntVect(AMREX_D_DECL(i,j,k)))];
+            for (int n = 0; n < ncomp; ++n) {
+                x(i,j,k,n) = y[r*ncomp+n];
+            }
+        });
+    }
+}
+
+}
@@ -41,6 +41,11 @@ namespace {
     int flag_use_mota = 0;
     int remap_nbh_lb = 1;
 
+    // Chebyshev smoother: power iterations for the eigenvalue estimate and
+    // ratio of the largest to the smallest eigenvalue it targets
+    int cheby_power_iters = 10;
+    Real cheby_eig_ratio = 10.0;
+
 #ifdef BL_USE_MPI
     class CommCache
     {
@@ -102,6 +107,8 @@ void MLLinOp::Initialize ()
     pp.query("comm_cache", flag_comm_cache);
     pp.query("mota", flag_use_mota);
     pp.query("remap_nbh_lb", remap_nbh_lb);
+    pp.query("cheby_power_iters", cheby_power_iters);
+    pp.query("cheby_eig_ratio", cheby_eig_ratio);
 
 #ifdef BL_USE_MPI
     comm_cache.reset(new CommCache());
@@ -931,6 +938,127 @@ MLLinOp::remapNeighborhoods (Vector<DistributionMapping> & dms)
 #endif
 }
 
+void
+MLLinOp::computeChebyshevBounds ()
+{
+    m_cheby_lambda.clear();
+    if (info.chebyshev_degree <= 0) return;
+
+    BL_PROFILE("MLLinOp::computeChebyshevBounds()");
+
+    const int ncomp = getNComp();
+    m_cheby_lambda.resize(m_num_amr_levels);
+    for (int amrlev = 0; amrlev < m_num_amr_levels; ++amrlev)
+    {
+        m_cheby_lambda[amrlev].resize(m_num_mg_levels[amrlev]);
+        for (int mglev = 0; mglev < m_num_mg_levels[amrlev]; ++mglev)
+        {
+            const BoxArray& ba = amrex::convert(m_grids[amrlev][mglev], m_ixtype);
+            const DistributionMapping& dm = m_dmap[amrlev][mglev];
+            MultiFab v(ba, dm, ncomp, 1, MFInfo(), *m_factory[amrlev][mglev]);
+            MultiFab w(ba, dm, ncomp, 0, MFInfo(), *m_factory[amrlev][mglev]);
+
+            // The starting vector only depends on the index, so the
+            // estimate does not depend on the domain decomposition.
+#ifdef _OPENMP
+#pragma omp parallel if (Gpu::notInLaunchRegion())
+#endif
+            for (MFIter mfi(v,TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const Box& bx = mfi.tilebox();
+                Array4<Real> const& varr = v.array(mfi);
+                AMREX_HOST_DEVICE_PARALLEL_FOR_4D ( bx, ncomp, i, j, k, n,
+                {
+                    unsigned int h = static_cast<unsigned int>(i)*73856093u
+                        ^ static_cast<unsigned int>(j)*19349663u
+                        ^ static_cast<unsigned int>(k)*83492791u
+                        ^ static_cast<unsigned int>(n)*2654435761u;
+                    h = (h ^ (h >> 16)) * 0x45d9f3bu;
+                    h ^= h >> 16;
+                    varr(i,j,k,n) = Real(h % 1024u) / Real(1024.) - Real(0.5);
+                });
+            }
+
+            Real lambda = 0.0;
+            for (int iter = 0; iter < cheby_power_iters; ++iter)
+            {
+                Real vnorm = 0.0;
+                for (int n = 0; n < ncomp; ++n) {
+                    vnorm = std::max(vnorm, v.norm0(n, 0, true));
+                }
+                ParallelAllReduce::Max(vnorm, ParallelContext::CommunicatorSub());
+                if (vnorm == Real(0.0)) break;
+                v.mult(Real(1.0)/vnorm, 0, ncomp, 0);
+
+                apply(amrlev, mglev, w, v, BCMode::Homogeneous, StateMode::Solution);
+                normalize(amrlev, mglev, w);
+
+                lambda = 0.0;
+                for (int n = 0; n < ncomp; ++n) {
+                    lambda = std::max(lambda, w.norm0(n, 0, true));
+                }
+                ParallelAllReduce::Max(lambda, ParallelContext::CommunicatorSub());
+                MultiFab::Copy(v, w, 0, 0, ncomp, 0);
+            }
+
+            // Power iteration approaches the largest eigenvalue from below.
+            m_cheby_lambda[amrlev][mglev] = Real(1.1)*lambda;
+
+            if (verbose > 2) {
+                amrex::Print() << "MLLinOp: Chebyshev eigenvalue bound on AMR level " << amrlev
+                               << " MG level " << mglev << ": "
+                               << m_cheby_lambda[amrlev][mglev] << "\n";
+            }
+        }
+    }
+}
+
+void
+MLLinOp::chebyshevSmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
+                          int niter) const
+{
+    BL_PROFILE("MLLinOp::chebyshevSmooth()");
+
+    const Real lmax = m_cheby_lambda[amrlev][mglev];
+    const Real lmin = lmax / cheby_eig_ratio;
+    const Real theta = Real(0.5)*(lmax+lmin);
+    const Real delta = Real(0.5)*(lmax-lmin);
+    const Real sigma = theta/delta;
+    Real rho = Real(1.0)/sigma;
+
+    const int ncomp = getNComp();
+    const BoxArray& ba = sol.boxArray();
+    const DistributionMapping& dm = sol.DistributionMap();
+    MultiFab r(ba, dm, ncomp, 0, MFInfo(), *m_factory[amrlev][mglev]);
+    MultiFab z(ba, dm, ncomp, 0, MFInfo(), *m_factory[amrlev][mglev]);
+    MultiFab d(ba, dm, ncomp, sol.nGrow(), MFInfo(), *m_factory[amrlev][mglev]);
+
+    // r = rhs - A sol, d = D^{-1} r / theta
+    apply(amrlev, mglev, r, sol, BCMode::Homogeneous, StateMode::Solution);
+    MultiFab::Xpay(r, Real(-1.0), rhs, 0, 0, ncomp, 0);
+    MultiFab::Copy(d, r, 0, 0, ncomp, 0);
+    normalize(amrlev, mglev, d);
+    d.mult(Real(1.0)/theta, 0, ncomp, 0);
+
+    // The sweeps continue one polynomial of degree niter*chebyshev_degree.
+    const int degree = niter*info.chebyshev_degree;
+    for (int k = 0; k < degree; ++k)
+    {
+        MultiFab::Add(sol, d, 0, 0, ncomp, 0);
+        if (k+1 == degree) break;
+
+        apply(amrlev, mglev, z, d, BCMode::Homogeneous, StateMode::Solution);
+        MultiFab::Subtract(r, z, 0, 0, ncomp, 0);
+        MultiFab::Copy(z, r, 0, 0, ncomp, 0);
+        normalize(amrlev, mglev, z);
+
+        const Real rho_new = Real(1.0)/(Real(2.0)*sigma - rho);
+        d.mult(rho_new*rho, 0, ncomp, 0);
+        MultiFab::Saxpy(d, Real(2.0)*rho_new/delta, z, 0, 0, ncomp, 0);
+        rho = rho_new;
+    }
+}
+
 #ifdef AMREX_USE_PETSC
 std::unique_ptr<PETScABecLap>
 MLLinOp::makePETSc () const
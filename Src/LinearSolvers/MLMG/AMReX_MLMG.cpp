@@ -4,6 +4,7 @@
 #include <AMReX_BC_TYPES.H>
 #include <AMReX_MLMG_K.H>
 #include <AMReX_MLABecLaplacian.H>
+#include <fstream>
 
 #ifdef AMREX_USE_PETSC
 #include <petscksp.h>
@@ -46,7 +47,45 @@ MLMG::MLMG (MLLinOp& a_lp)
 {}
 
 MLMG::~MLMG ()
-{}
+{
+    if (perf_stats) linop.setPerfStats(nullptr);
+}
+
+void
+MLMG::setPerfReport (const std::string& file_name)
+{
+    perf_report_file = file_name;
+    if (file_name.empty()) {
+        perf_stats.reset();
+    } else if (perf_stats == nullptr) {
+        perf_stats.reset(new MLPerfStats());
+        definePerfStats();
+    }
+    linop.setPerfStats(perf_stats.get());
+}
+
+void
+MLMG::definePerfStats ()
+{
+    Vector<int> nmglevs(namrlevs);
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        nmglevs[alev] = linop.NMGLevels(alev);
+    }
+    perf_stats->define(nmglevs);
+}
+
+void
+MLMG::writePerfReport ()
+{
+    std::ofstream ofs;
+    if (ParallelContext::MyProcSub() == 0) {
+        ofs.open(perf_report_file, std::ios::app);
+        if (!ofs.good()) {
+            amrex::FileOpenFailed(perf_report_file);
+        }
+    }
+    perf_stats->writeJSON(ofs, solve_called, getNumIters(), timer[solve_time]);
+}
 
 Real
 MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs,
@@ -58,19 +97,8 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         checkPoint(a_sol, a_rhs, a_tol_rel, a_tol_abs, checkpoint_file);
     }
 
-    if (bottom_solver == BottomSolver::Default) {
-        bottom_solver = linop.getDefaultBottomSolver();
-    }
+    prepareBottomSolver(a_sol);
 
-    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc) {
-        int mo = linop.getMaxOrder();
-        if (a_sol[0]->hasEBFabFactory()) {
-            linop.setMaxOrder(2);
-        } else {
-            linop.setMaxOrder(std::min(3,mo));  // maxorder = 4 not supported
-        }
-    }
-    
     bool is_nsolve = linop.m_parent;
 
     Real solve_start_time = amrex::second();
@@ -118,6 +146,10 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
         if (verbose >= 1) {
             amrex::Print() << "MLMG: No iterations needed\n";
         }
+    } else if (!is_nsolve && krylov_solver != KrylovSolver::none) {
+        Real iter_start_time = amrex::second();
+        composite_norminf = solveKrylov(res_target, max_norm, norm_name);
+        timer[iter_time] = amrex::second() - iter_start_time;
     } else {
         Real iter_start_time = amrex::second();
         bool converged = false;
@@ -204,6 +236,183 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
     }
 
     timer[solve_time] = amrex::second() - solve_start_time;
+    if (perf_stats) writePerfReport();
+    if (verbose >= 1) {
+        ParallelReduce::Max<Real>(timer.data(), timer.size(), 0,
+                                  ParallelContext::CommunicatorSub());
+        if (ParallelContext::MyProcSub() == 0)
+        {
+            amrex::AllPrint() << "MLMG: Timers: Solve = " << timer[solve_time]
+                              << " Iter = " << timer[iter_time]
+                              << " Bottom = " << timer[bottom_time] << "\n";
+        }
+    }
+
+    ++solve_called;
+
+    return composite_norminf;
+}
+
+Vector<Real>
+MLMG::solveBatch (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rhs,
+                  Real a_tol_rel, Real a_tol_abs)
+{
+    BL_PROFILE("MLMG::solveBatch()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(linop.hasIndependentComponents(),
+                                     "MLMG::solveBatch: components of the operator are coupled");
+
+    prepareBottomSolver(a_sol);
+
+    Real solve_start_time = amrex::second();
+
+    m_niters_cg.clear();
+    m_iter_fine_resnorm0.clear();
+
+    prepareForSolve(a_sol, a_rhs);
+
+    computeMLResidual(finest_amr_lev);
+
+    const int ncomp = linop.getNComp();
+
+    // One reduction for the residual and rhs norms of all components
+    Vector<Real> norm0 = MLResNormInfComp(finest_amr_lev, true);
+    {
+        const Vector<Real>& rhsnorm0 = MLRhsNormInfComp(true);
+        norm0.insert(norm0.end(), rhsnorm0.begin(), rhsnorm0.end());
+    }
+    ParallelAllReduce::Max(norm0.data(), 2*ncomp, ParallelContext::CommunicatorSub());
+
+    Vector<Real> max_norm(ncomp);
+    Vector<Real> res_target(ncomp);
+    Vector<Real> resnorm(norm0.begin(), norm0.begin()+ncomp);
+    m_batch_converged.assign(ncomp, 0);
+    m_batch_niters.assign(ncomp, 0);
+    int nconverged = 0;
+    for (int n = 0; n < ncomp; ++n)
+    {
+        const Real resnorm0 = norm0[n];
+        const Real rhsnorm0 = norm0[ncomp+n];
+        max_norm[n] = (always_use_bnorm or rhsnorm0 >= resnorm0) ? rhsnorm0 : resnorm0;
+        res_target[n] = std::max(a_tol_abs, std::max(a_tol_rel,Real(1.e-16))*max_norm[n]);
+        if (resnorm0 <= res_target[n]) {
+            m_batch_converged[n] = 1;
+            ++nconverged;
+        }
+    }
+
+    m_init_resnorm0 = *std::max_element(norm0.begin(), norm0.begin()+ncomp);
+    m_rhsnorm0 = *std::max_element(norm0.begin()+ncomp, norm0.end());
+
+    if (verbose >= 1)
+    {
+        amrex::Print() << "MLMG: Batch of " << ncomp << " right-hand sides\n"
+                       << "MLMG: Initial rhs               = " << m_rhsnorm0 << "\n"
+                       << "MLMG: Initial residual (resid0) = " << m_init_resnorm0 << "\n";
+    }
+
+    if (nconverged == ncomp) {
+        if (verbose >= 1) {
+            amrex::Print() << "MLMG: No iterations needed\n";
+        }
+    } else {
+        Real iter_start_time = amrex::second();
+
+        const int niters = do_fixed_number_of_iters ? do_fixed_number_of_iters : max_iters;
+        for (int iter = 0; iter < niters; ++iter)
+        {
+            oneIter(iter);
+
+            // Test convergence on the fine amr level
+            computeResidual(finest_amr_lev);
+
+            const Vector<Real>& fine_norminf = ResNormInfComp(finest_amr_lev);
+            m_iter_fine_resnorm0.push_back(*std::max_element(fine_norminf.begin(),
+                                                             fine_norminf.end()));
+
+            bool test_crse = false;
+            for (int n = 0; n < ncomp; ++n) {
+                if (!m_batch_converged[n]) {
+                    resnorm[n] = fine_norminf[n];
+                    test_crse = test_crse || (namrlevs > 1 and resnorm[n] <= res_target[n]);
+                }
+            }
+
+            if (test_crse) {
+                // some finest levels are converged, but we still need to test the coarse levels
+                computeMLResidual(finest_amr_lev-1);
+                const Vector<Real>& crse_norminf = MLResNormInfComp(finest_amr_lev-1);
+                for (int n = 0; n < ncomp; ++n) {
+                    if (!m_batch_converged[n]) {
+                        resnorm[n] = std::max(resnorm[n], crse_norminf[n]);
+                    }
+                }
+            }
+
+            Real max_ratio = 0.0;
+            for (int n = 0; n < ncomp; ++n)
+            {
+                if (m_batch_converged[n]) continue;
+                max_ratio = std::max(max_ratio, resnorm[n]/max_norm[n]);
+                if (resnorm[n] <= res_target[n]) {
+                    m_batch_converged[n] = 1;
+                    m_batch_niters[n] = iter+1;
+                    ++nconverged;
+                    if (verbose >= 2) {
+                        amrex::Print() << "MLMG: Component " << n << " converged after "
+                                       << iter+1 << " iterations, resid = " << resnorm[n] << "\n";
+                    }
+                } else if (resnorm[n] > 1.e20*max_norm[n]) {
+                    if (verbose > 0) {
+                        amrex::Print() << "MLMG: Component " << n << " failing to converge after "
+                                       << iter+1 << " iterations. resid = " << resnorm[n] << "\n";
+                    }
+                    amrex::Abort("MLMG failing so lets stop here");
+                }
+            }
+
+            if (verbose >= 2) {
+                amrex::Print() << "MLMG: Iteration " << std::setw(3) << iter+1 << " "
+                               << nconverged << " of " << ncomp << " converged,"
+                               << " max unconverged resid/norm = " << max_ratio << "\n";
+            }
+
+            if (nconverged == ncomp) {
+                if (verbose >= 1) {
+                    amrex::Print() << "MLMG: Final Iter. " << iter+1
+                                   << " max resid = " << *std::max_element(resnorm.begin(),
+                                                                           resnorm.end())
+                                   << "\n";
+                }
+                break;
+            }
+        }
+
+        if (nconverged < ncomp && do_fixed_number_of_iters == 0) {
+            if (verbose > 0) {
+                amrex::Print() << "MLMG: Failed to converge after " << max_iters << " iterations."
+                               << " " << ncomp-nconverged << " of " << ncomp
+                               << " right-hand sides are not converged\n";
+            }
+            amrex::Abort("MLMG failed");
+        }
+        timer[iter_time] = amrex::second() - iter_start_time;
+    }
+
+    m_batch_converged.clear();
+    m_final_resnorm0 = *std::max_element(resnorm.begin(), resnorm.end());
+
+    int ng_back = final_fill_bc ? 1 : 0;
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        if (a_sol[alev] != sol[alev])
+        {
+            MultiFab::Copy(*a_sol[alev], *sol[alev], 0, 0, ncomp, ng_back);
+        }
+    }
+
+    timer[solve_time] = amrex::second() - solve_start_time;
+    if (perf_stats) writePerfReport();
     if (verbose >= 1) {
         ParallelReduce::Max<Real>(timer.data(), timer.size(), 0,
                                   ParallelContext::CommunicatorSub());
@@ -217,9 +426,398 @@ MLMG::solve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab const*>& a_rh
 
     ++solve_called;
 
+    return resnorm;
+}
+
+void
+MLMG::prepareBottomSolver (const Vector<MultiFab*>& a_sol)
+{
+    if (bottom_solver == BottomSolver::Default) {
+        bottom_solver = linop.getDefaultBottomSolver();
+    }
+
+    if (bottom_solver == BottomSolver::lu) {
+        const Long nentries = MLLUSolver::estimateEntries(linop);
+        if (nentries > lu_max_entries) {
+            bottom_solver = linop.getDefaultBottomSolver();
+            if (verbose >= 1) {
+                amrex::Print() << "MLMG: Warning: LU bottom solver would need about "
+                               << nentries << " entries, more than lu_max_entries = "
+                               << lu_max_entries << "; using the default bottom solver\n";
+            }
+        }
+    }
+
+    if (bottom_solver == BottomSolver::hypre || bottom_solver == BottomSolver::petsc ||
+        bottom_solver == BottomSolver::lu) {
+        int mo = linop.getMaxOrder();
+        if (a_sol[0]->hasEBFabFactory()) {
+            linop.setMaxOrder(2);
+        } else {
+            linop.setMaxOrder(std::min(3,mo));  // maxorder = 4 not supported
+        }
+    }
+}
+
+void
+MLMG::maskConvergedComps (MultiFab& mf) const
+{
+    for (int n = 0, N = m_batch_converged.size(); n < N; ++n) {
+        if (m_batch_converged[n]) {
+            mf.setVal(0.0, n, 1, mf.nGrow());
+        }
+    }
+}
+
+// Outer Krylov iteration preconditioned by MLMG cycles.  The composite
+// operator L is affine because of the boundary data, so the Krylov
+// method works with A v = L(v) - L(0).  An MLMG cycle started from zero
+// for rhs = v + L(0) is linear in v and is used as the preconditioner.
+Real
+MLMG::solveKrylov (Real res_target, Real max_norm, const std::string& norm_name)
+{
+    BL_PROFILE("MLMG::solveKrylov()");
+
+    AMREX_ALWAYS_ASSERT_WITH_MESSAGE(linop.isCellCentered() || namrlevs == 1,
+                                     "MLMG: Krylov solvers for nodal operators need a single AMR level");
+
+    const int ncomp = linop.getNComp();
+
+    Vector<MultiFab> x(namrlevs), b(namrlevs), zero(namrlevs);
+    krylov_l0.resize(namrlevs);
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        const BoxArray& ba = rhs[alev].boxArray();
+        const DistributionMapping& dm = rhs[alev].DistributionMap();
+        x[alev].define(ba, dm, ncomp, sol[alev]->nGrow(), MFInfo(), *linop.Factory(alev));
+        zero[alev].define(ba, dm, ncomp, sol[alev]->nGrow(), MFInfo(), *linop.Factory(alev));
+        b[alev].define(ba, dm, ncomp, rhs[alev].nGrow(), MFInfo(), *linop.Factory(alev));
+        krylov_l0[alev].define(ba, dm, ncomp, 0, MFInfo(), *linop.Factory(alev));
+        x[alev].setVal(0.0);
+        MultiFab::Copy(x[alev], *sol[alev], 0, 0, ncomp, 0);
+        MultiFab::Copy(b[alev], rhs[alev], 0, 0, ncomp, rhs[alev].nGrow());
+        zero[alev].setVal(0.0);
+    }
+
+    // krylov_l0 = L(0)
+    computeMLResidual(krylov_l0, zero, zero);
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        krylov_l0[alev].negate(0);
+    }
+    zero.clear();
+
+    Real composite_norminf = (krylov_solver == KrylovSolver::cg)
+        ? solveFCG(x, b, res_target, max_norm, norm_name)
+        : solveFGMRES(x, b, res_target, max_norm, norm_name);
+
+    // Restore the state of a plain solve with the final solution, which
+    // also leaves the boundary data of linop set from it.
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        MultiFab::Copy(*sol[alev], x[alev], 0, 0, ncomp, 0);
+        MultiFab::Copy(rhs[alev], b[alev], 0, 0, ncomp, rhs[alev].nGrow());
+    }
+    computeMLResidual(finest_amr_lev);
+    krylov_l0.clear();
+
     return composite_norminf;
 }
 
+Real
+MLMG::solveFGMRES (Vector<MultiFab>& x, const Vector<MultiFab>& b,
+                   Real res_target, Real max_norm, const std::string& norm_name)
+{
+    BL_PROFILE("MLMG::solveFGMRES()");
+
+    const int ncomp = linop.getNComp();
+    const int m = std::max(krylov_restart, 1);
+    const int niters = do_fixed_number_of_iters ? do_fixed_number_of_iters : max_iters;
+
+    // Krylov basis V and preconditioned directions Z
+    Vector<Vector<MultiFab> > V(m+1), Z(m);
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        const BoxArray& ba = rhs[alev].boxArray();
+        const DistributionMapping& dm = rhs[alev].DistributionMap();
+        for (int j = 0; j <= m; ++j) {
+            V[j].resize(namrlevs);
+            V[j][alev].define(ba, dm, ncomp, 0, MFInfo(), *linop.Factory(alev));
+        }
+        for (int j = 0; j < m; ++j) {
+            Z[j].resize(namrlevs);
+            Z[j][alev].define(ba, dm, ncomp, sol[alev]->nGrow(), MFInfo(), *linop.Factory(alev));
+        }
+    }
+
+    Vector<Vector<Real> > H(m+1, Vector<Real>(m));
+    Vector<Real> cs(m), sn(m), g(m+1), y(m), d(m+1);
+
+    Real norminf = 0.0;
+    bool converged = false;
+    int iter = 0;
+    while (true)
+    {
+        computeMLResidual(V[0], x, b);
+        norminf = MLNormInf(V[0]);
+        if (norminf <= res_target) {
+            converged = true;
+            break;
+        }
+        if (iter >= niters) break;
+        if (norminf > 1.e20*max_norm) {
+            amrex::Print() << "MLMG: FGMRES failing to converge after " << iter << " iterations."
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+            amrex::Abort("MLMG failing so lets stop here");
+        }
+
+        const Real beta = std::sqrt(MLDot(V[0], V[0]));
+        for (int alev = 0; alev < namrlevs; ++alev) {
+            V[0][alev].mult(1.0/beta, 0, ncomp, 0);
+        }
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        int k = 0;
+        while (k < m && iter < niters)
+        {
+            krylovPrecond(Z[k], V[k], iter);
+            krylovApply(V[k+1], Z[k]);
+
+            // Classical Gram-Schmidt with one reorthogonalization, so that
+            // each pass needs only one reduction.
+            for (int i = 0; i <= k; ++i) H[i][k] = 0.0;
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                for (int i = 0; i <= k; ++i) {
+                    d[i] = MLDot(V[k+1], V[i], true);
+                }
+                ParallelAllReduce::Sum(d.data(), k+1, ParallelContext::CommunicatorSub());
+                for (int i = 0; i <= k; ++i) {
+                    H[i][k] += d[i];
+                    for (int alev = 0; alev < namrlevs; ++alev) {
+                        MultiFab::Saxpy(V[k+1][alev], -d[i], V[i][alev], 0, 0, ncomp, 0);
+                    }
+                }
+            }
+            const Real hnorm = std::sqrt(MLDot(V[k+1], V[k+1]));
+            H[k+1][k] = hnorm;
+            if (hnorm > 0.0) {
+                for (int alev = 0; alev < namrlevs; ++alev) {
+                    V[k+1][alev].mult(1.0/hnorm, 0, ncomp, 0);
+                }
+            }
+
+            // Givens rotations for the least squares problem
+            for (int i = 0; i < k; ++i) {
+                const Real t = cs[i]*H[i][k] + sn[i]*H[i+1][k];
+                H[i+1][k] = -sn[i]*H[i][k] + cs[i]*H[i+1][k];
+                H[i][k] = t;
+            }
+            const Real rr = std::sqrt(H[k][k]*H[k][k] + H[k+1][k]*H[k+1][k]);
+            cs[k] = (rr > 0.0) ? H[k][k]/rr : 1.0;
+            sn[k] = (rr > 0.0) ? H[k+1][k]/rr : 0.0;
+            H[k][k] = rr;
+            H[k+1][k] = 0.0;
+            g[k+1] = -sn[k]*g[k];
+            g[k]   =  cs[k]*g[k];
+
+            ++k;
+            ++iter;
+
+            // The 2-norm of the residual is known without computing it.
+            // Its reduction is used to estimate the inf-norm.
+            const Real est = std::abs(g[k])/beta * norminf;
+            m_iter_fine_resnorm0.push_back(est);
+            if (verbose >= 2) {
+                amrex::Print() << "MLMG: FGMRES Iteration " << std::setw(3) << iter
+                               << " resid/" << norm_name << " (estimate) = "
+                               << est/max_norm << "\n";
+            }
+            if (est <= res_target || hnorm == 0.0) break;
+        }
+
+        // x += Z y, with H y = g
+        for (int i = k-1; i >= 0; --i) {
+            Real t = g[i];
+            for (int j = i+1; j < k; ++j) {
+                t -= H[i][j]*y[j];
+            }
+            y[i] = (H[i][i] != 0.0) ? t/H[i][i] : 0.0;
+        }
+        for (int j = 0; j < k; ++j) {
+            for (int alev = 0; alev < namrlevs; ++alev) {
+                MultiFab::Saxpy(x[alev], y[j], Z[j][alev], 0, 0, ncomp, 0);
+            }
+        }
+    }
+
+    if (converged) {
+        if (verbose >= 1) {
+            amrex::Print() << "MLMG: FGMRES Final Iter. " << iter
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+        }
+    } else if (do_fixed_number_of_iters == 0) {
+        if (verbose > 0) {
+            amrex::Print() << "MLMG: FGMRES Failed to converge after " << iter << " iterations."
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+        }
+        amrex::Abort("MLMG failed");
+    }
+
+    return norminf;
+}
+
+// Flexible preconditioned CG, which allows for an MLMG cycle that is not
+// exactly symmetric.
+Real
+MLMG::solveFCG (Vector<MultiFab>& x, const Vector<MultiFab>& b,
+                Real res_target, Real max_norm, const std::string& norm_name)
+{
+    BL_PROFILE("MLMG::solveFCG()");
+
+    const int ncomp = linop.getNComp();
+    const int niters = do_fixed_number_of_iters ? do_fixed_number_of_iters : max_iters;
+
+    Vector<MultiFab> r(namrlevs), z(namrlevs), p(namrlevs), q(namrlevs);
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        const BoxArray& ba = rhs[alev].boxArray();
+        const DistributionMapping& dm = rhs[alev].DistributionMap();
+        r[alev].define(ba, dm, ncomp, 0, MFInfo(), *linop.Factory(alev));
+        z[alev].define(ba, dm, ncomp, 0, MFInfo(), *linop.Factory(alev));
+        p[alev].define(ba, dm, ncomp, sol[alev]->nGrow(), MFInfo(), *linop.Factory(alev));
+        q[alev].define(ba, dm, ncomp, 0, MFInfo(), *linop.Factory(alev));
+    }
+
+    computeMLResidual(r, x, b);
+    Real norminf = MLNormInf(r);
+    bool true_residual = true;
+    bool restart = true;
+    bool converged = false;
+    Real rho = 0.0, alpha = 0.0;
+    int iter = 0;
+    while (true)
+    {
+        // The recursively updated residual is confirmed before stopping.
+        if (norminf <= res_target && !true_residual) {
+            computeMLResidual(r, x, b);
+            norminf = MLNormInf(r);
+            true_residual = true;
+            restart = true;
+        }
+        if (norminf <= res_target) {
+            converged = true;
+            break;
+        }
+        if (iter >= niters) break;
+        if (norminf > 1.e20*max_norm) {
+            amrex::Print() << "MLMG: CG failing to converge after " << iter << " iterations."
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+            amrex::Abort("MLMG failing so lets stop here");
+        }
+
+        krylovPrecond(z, r, iter);
+
+        if (restart) {
+            rho = MLDot(z, r);
+            for (int alev = 0; alev < namrlevs; ++alev) {
+                MultiFab::Copy(p[alev], z[alev], 0, 0, ncomp, 0);
+            }
+            restart = false;
+        } else {
+            // Since r - r_old = -alpha q, the flexible beta needs (z,q).
+            Real dots[2] = { MLDot(z, r, true), MLDot(z, q, true) };
+            ParallelAllReduce::Sum(dots, 2, ParallelContext::CommunicatorSub());
+            const Real beta = -alpha*dots[1]/rho;
+            rho = dots[0];
+            for (int alev = 0; alev < namrlevs; ++alev) {
+                MultiFab::Xpay(p[alev], beta, z[alev], 0, 0, ncomp, 0);
+            }
+        }
+
+        krylovApply(q, p);
+        const Real pq = MLDot(p, q);
+        if (pq == 0.0) break;
+        alpha = rho/pq;
+
+        for (int alev = 0; alev < namrlevs; ++alev) {
+            MultiFab::Saxpy(x[alev],  alpha, p[alev], 0, 0, ncomp, 0);
+            MultiFab::Saxpy(r[alev], -alpha, q[alev], 0, 0, ncomp, 0);
+        }
+        true_residual = false;
+        ++iter;
+
+        norminf = MLNormInf(r);
+        m_iter_fine_resnorm0.push_back(norminf);
+        if (verbose >= 2) {
+            amrex::Print() << "MLMG: CG Iteration " << std::setw(3) << iter
+                           << " resid/" << norm_name << " = " << norminf/max_norm << "\n";
+        }
+    }
+
+    if (!true_residual) {
+        computeMLResidual(r, x, b);
+        norminf = MLNormInf(r);
+    }
+
+    if (converged) {
+        if (verbose >= 1) {
+            amrex::Print() << "MLMG: CG Final Iter. " << iter
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+        }
+    } else if (do_fixed_number_of_iters == 0) {
+        if (verbose > 0) {
+            amrex::Print() << "MLMG: CG Failed to converge after " << iter << " iterations."
+                           << " resid, resid/" << norm_name << " = "
+                           << norminf << ", " << norminf/max_norm << "\n";
+        }
+        amrex::Abort("MLMG failed");
+    }
+
+    return norminf;
+}
+
+void
+MLMG::krylovApply (Vector<MultiFab>& out, Vector<MultiFab>& in)
+{
+    BL_PROFILE("MLMG::krylovApply()");
+    // out = L(0) - L(in)
+    computeMLResidual(out, in, krylov_l0);
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        out[alev].negate(0);
+    }
+}
+
+void
+MLMG::krylovPrecond (Vector<MultiFab>& z, const Vector<MultiFab>& v, int iter)
+{
+    BL_PROFILE("MLMG::krylovPrecond()");
+
+    const int ncomp = linop.getNComp();
+    for (int alev = 0; alev < namrlevs; ++alev)
+    {
+        MultiFab::LinComb(rhs[alev], 1.0, v[alev], 0, 1.0, krylov_l0[alev], 0, 0, ncomp, 0);
+        MultiFab::Copy(res[alev][0], v[alev], 0, 0, ncomp, 0);
+        sol[alev]->setVal(0.0);
+    }
+    // oneIter expects the boundary data of the fine levels to come from
+    // the current coarse solution.
+    for (int alev = 1; alev < namrlevs; ++alev) {
+        linop.fillSolutionBC(alev, *sol[alev], sol[alev-1]);
+    }
+
+    oneIter(iter);
+
+    for (int alev = 0; alev < namrlevs; ++alev) {
+        MultiFab::Copy(z[alev], *sol[alev], 0, 0, ncomp, 0);
+    }
+}
+
 // in  : Residual (res) on the finest AMR level
 // out : sol on all AMR levels
 void MLMG::oneIter (int iter)
@@ -230,6 +828,9 @@ void MLMG::oneIter (int iter)
     int nghost = 0;
     if (cf_strategy == CFStrategy::ghostnodes) nghost = linop.getNGrow();
 
+    // A zero residual keeps the solution of a converged component as it is.
+    if (!m_batch_converged.empty()) maskConvergedComps(res[finest_amr_lev][0]);
+
     for (int alev = finest_amr_lev; alev > 0; --alev)
     {
         miniCycle(alev);
@@ -238,6 +839,7 @@ void MLMG::oneIter (int iter)
 
         // compute residual for the coarse AMR level
         computeResWithCrseSolFineCor(alev-1,alev);
+        if (!m_batch_converged.empty()) maskConvergedComps(res[alev-1][0]);
 
         if (alev != finest_amr_lev) {
             std::swap(cor_hold[alev][0], cor[alev][0]); // save it for the up cycle
@@ -295,6 +897,7 @@ MLMG::computeMLResidual (int amrlevmax)
 
     const int mglev = 0;
     for (int alev = amrlevmax; alev >= 0; --alev) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, alev, mglev, &res[alev][mglev]);
         const MultiFab* crse_bcdata = (alev > 0) ? sol[alev-1] : nullptr;
         linop.solutionResidual(alev, res[alev][mglev], *sol[alev], rhs[alev], crse_bcdata);
         if (alev < finest_amr_lev) {
@@ -304,6 +907,34 @@ MLMG::computeMLResidual (int amrlevmax)
     }
 }
 
+// Compute multi-level residual a_res = a_rhs - L(a_sol) on all AMR levels.
+void
+MLMG::computeMLResidual (Vector<MultiFab>& a_res, Vector<MultiFab>& a_sol,
+                         const Vector<MultiFab>& a_rhs)
+{
+    BL_PROFILE("MLMG::computeMLResidual()");
+
+    const int ncomp = linop.getNComp();
+    const auto& amrrr = linop.AMRRefRatio();
+    for (int alev = finest_amr_lev; alev >= 0; --alev) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, alev, 0, &a_res[alev]);
+        const MultiFab* crse_bcdata = (alev > 0) ? &a_sol[alev-1] : nullptr;
+        linop.solutionResidual(alev, a_res[alev], a_sol[alev], a_rhs[alev], crse_bcdata);
+        if (alev < finest_amr_lev) {
+            linop.reflux(alev, a_res[alev], a_sol[alev], a_rhs[alev],
+                         a_res[alev+1], a_sol[alev+1], a_rhs[alev+1]);
+            if (linop.isCellCentered()) {
+                MLPerfStats::Timer perfr(perf_stats.get(), MLPerfStats::restriction, alev, 0, &a_res[alev+1]);
+#ifdef AMREX_USE_EB
+                amrex::EB_average_down(a_res[alev+1], a_res[alev], 0, ncomp, amrrr[alev]);
+#else
+                amrex::average_down(a_res[alev+1], a_res[alev], 0, ncomp, amrrr[alev]);
+#endif
+            }
+        }
+    }
+}
+
 // Compute single AMR level residual without masking.
 void
 MLMG::computeResidual (int alev)
@@ -318,6 +949,7 @@ MLMG::computeResidual (int alev)
     if (alev > 0) {
         crse_bcdata = sol[alev-1];
     }
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, alev, 0, &r);
     linop.solutionResidual(alev, r, x, b, crse_bcdata);
 }
 
@@ -345,14 +977,24 @@ MLMG::computeResWithCrseSolFineCor (int calev, int falev)
     if (calev > 0) {
         crse_bcdata = sol[calev-1];
     }
-    linop.solutionResidual(calev, crse_res, crse_sol, crse_rhs, crse_bcdata);
+    {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, calev, 0, &crse_res);
+        linop.solutionResidual(calev, crse_res, crse_sol, crse_rhs, crse_bcdata);
+    }
 
-    linop.correctionResidual(falev, 0, fine_rescor, fine_cor, fine_res, BCMode::Homogeneous);
+    {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, falev, 0, &fine_rescor);
+        linop.correctionResidual(falev, 0, fine_rescor, fine_cor, fine_res, BCMode::Homogeneous);
+    }
     MultiFab::Copy(fine_res, fine_rescor, 0, 0, ncomp, nghost);
 
-    linop.reflux(calev, crse_res, crse_sol, crse_rhs, fine_res, fine_sol, fine_rhs);
+    {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, calev, 0);
+        linop.reflux(calev, crse_res, crse_sol, crse_rhs, fine_res, fine_sol, fine_rhs);
+    }
 
     if (linop.isCellCentered()) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::restriction, calev, 0, &fine_res);
         const int amrrr = linop.AMRRefRatio(calev);
 #ifdef AMREX_USE_EB
         amrex::EB_average_down(fine_res, crse_res, 0, ncomp, amrrr);
@@ -379,8 +1021,11 @@ MLMG::computeResWithCrseCorFineCor (int falev)
     MultiFab& fine_rescor = rescor[falev][0];
 
     // fine_rescor = fine_res - L(fine_cor)
-    linop.correctionResidual(falev, 0, fine_rescor, fine_cor, fine_res,
-                             BCMode::Inhomogeneous, &crse_cor);
+    {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, falev, 0, &fine_rescor);
+        linop.correctionResidual(falev, 0, fine_rescor, fine_cor, fine_res,
+                                 BCMode::Inhomogeneous, &crse_cor);
+    }
     MultiFab::Copy(fine_res, fine_rescor, 0, 0, ncomp, nghost);
 }
 
@@ -434,10 +1079,11 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
 
         cor[amrlev][mglev]->setVal(0.0);
         bool skip_fillboundary = true;
-        for (int i = 0; i < nu1; ++i) {
+        {
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::smooth, amrlev, mglev,
+                                    cor[amrlev][mglev].get());
             linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev],
-                         skip_fillboundary);
-            skip_fillboundary = false;
+                         skip_fillboundary, nu1);
         }
 
         // rescor = res - L(cor)
@@ -451,7 +1097,11 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
         }
 
         // res_crse = R(rescor_fine); this provides res/b to the level below
-        linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
+        {
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::restriction, amrlev, mglev+1,
+                                    &res[amrlev][mglev+1]);
+            linop.restriction(amrlev, mglev+1, res[amrlev][mglev+1], rescor[amrlev][mglev]);
+        }
 
     }
 
@@ -484,10 +1134,11 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
         }
         cor[amrlev][mglev_bottom]->setVal(0.0);
         bool skip_fillboundary = true;
-        for (int i = 0; i < nu1; ++i) {
+        {
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::smooth, amrlev, mglev_bottom,
+                                    cor[amrlev][mglev_bottom].get());
             linop.smooth(amrlev, mglev_bottom, *cor[amrlev][mglev_bottom], res[amrlev][mglev_bottom],
-                         skip_fillboundary);
-            skip_fillboundary = false;
+                         skip_fillboundary, nu1);
         }
         if (verbose >= 4)
         {
@@ -512,8 +1163,10 @@ MLMG::mgVcycle (int amrlev, int mglev_top)
             amrex::Print() << "AT LEVEL "  << amrlev << " " << mglev
                            << "   UP: Norm before smooth " << norm << "\n";
         }
-        for (int i = 0; i < nu2; ++i) {
-            linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev]);
+        {
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::smooth, amrlev, mglev,
+                                    cor[amrlev][mglev].get());
+            linop.smooth(amrlev, mglev, *cor[amrlev][mglev], res[amrlev][mglev], false, nu2);
         }
 
 	if (cf_strategy == CFStrategy::ghostnodes) computeResOfCorrection(amrlev, mglev);
@@ -545,6 +1198,8 @@ MLMG::mgFcycle ()
 
     for (int mglev = 1; mglev <= mg_bottom_lev; ++mglev)
     {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::restriction, amrlev, mglev,
+                                &res[amrlev][mglev]);
 #ifdef AMREX_USE_EB
         amrex::EB_average_down(res[amrlev][mglev-1], res[amrlev][mglev], 0, ncomp, ratio);
 #else
@@ -576,6 +1231,8 @@ void
 MLMG::interpCorrection (int alev)
 {
     BL_PROFILE("MLMG::interpCorrection_1");
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::interpolation, alev, 0,
+                            cor[alev][0].get());
 
     const int ncomp = linop.getNComp();
     int nghost = 0;
@@ -715,6 +1372,8 @@ void
 MLMG::interpCorrection (int alev, int mglev)
 {
     BL_PROFILE("MLMG::interpCorrection_2");
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::interpolation, alev, mglev,
+                            cor[alev][mglev].get());
 
     MultiFab& crse_cor = *cor[alev][mglev+1];
     MultiFab& fine_cor = *cor[alev][mglev  ];
@@ -823,6 +1482,8 @@ void
 MLMG::addInterpCorrection (int alev, int mglev)
 {
     BL_PROFILE("MLMG::addInterpCorrection()");
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::interpolation, alev, mglev,
+                            cor[alev][mglev].get());
 
     const int ncomp = linop.getNComp();
 
@@ -862,6 +1523,7 @@ MLMG::computeResOfCorrection (int amrlev, int mglev)
     MultiFab& x = *cor[amrlev][mglev];
     const MultiFab& b = res[amrlev][mglev];
     MultiFab& r = rescor[amrlev][mglev];
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::apply, amrlev, mglev, &r);
     linop.correctionResidual(amrlev, mglev, r, x, b, BCMode::Homogeneous);
 }
 
@@ -871,6 +1533,8 @@ MLMG::computeResOfCorrection (int amrlev, int mglev)
 void
 MLMG::bottomSolve ()
 {
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::bottom, 0, linop.NMGLevels(0)-1,
+                            cor[0].back().get());
     if (do_nsolve)
     {
         NSolve(*ns_mlmg, *ns_sol, *ns_rhs);
@@ -920,10 +1584,8 @@ MLMG::actualBottomSolve ()
     {
 
         bool skip_fillboundary = true;
-        for (int i = 0; i < nuf; ++i) {
-            linop.smooth(amrlev, mglev, x, b, skip_fillboundary);
-            skip_fillboundary = false;
-        }
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::smooth, amrlev, mglev, &x);
+        linop.smooth(amrlev, mglev, x, b, skip_fillboundary, nuf);
     }
     else
     {
@@ -947,12 +1609,20 @@ MLMG::actualBottomSolve ()
         {
             bottomSolveWithPETSc(x, *bottom_b);
         }
+        else if (bottom_solver == BottomSolver::lu)
+        {
+            bottomSolveWithLU(x, *bottom_b);
+        }
         else
         {
             MLCGSolver::Type cg_type;
             if (bottom_solver == BottomSolver::cg ||
                 bottom_solver == BottomSolver::cgbicg) {
                 cg_type = MLCGSolver::Type::CG;
+            } else if (bottom_solver == BottomSolver::pipecg) {
+                cg_type = MLCGSolver::Type::PipelinedCG;
+            } else if (bottom_solver == BottomSolver::pipebicgstab) {
+                cg_type = MLCGSolver::Type::PipelinedBiCGStab;
             } else {
                 cg_type = MLCGSolver::Type::BiCGStab;
             }
@@ -980,9 +1650,8 @@ MLMG::actualBottomSolve ()
                 }
             }
             const int n = (ret==0) ? nub : nuf;
-            for (int i = 0; i < n; ++i) {
-                linop.smooth(amrlev, mglev, x, b);
-            }
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::smooth, amrlev, mglev, &x);
+            linop.smooth(amrlev, mglev, x, b, false, n);
         }
     }
 
@@ -1008,14 +1677,114 @@ MLMG::bottomSolveWithCG (MultiFab& x, const MultiFab& b, MLCGSolver::Type type)
     return ret;
 }
 
+void
+MLMG::bottomSolveWithLU (MultiFab& x, const MultiFab& b)
+{
+    BL_PROFILE("MLMG::bottomSolveWithLU()");
+
+    if (lu_solver == nullptr)  // The factorization is reused until the linop is updated.
+    {
+        lu_solver.reset(new MLLUSolver(linop));
+        lu_solver->setVerbose(bottom_verbose);
+        lu_solver->define(x);
+    }
+
+    lu_solver->solve(x, b);
+
+    // Like the Krylov solvers starting from zero, return the solution
+    // without a component in the null space.
+    if (linop.isBottomSingular()) {
+        makeSolvable(0, linop.NMGLevels(0)-1, x);
+    }
+}
+
 // Compute single-level masked inf-norm of Residual (res).
 Real
 MLMG::ResNormInf (int alev, bool local)
 {
     BL_PROFILE("MLMG::ResNormInf()");
+    const Vector<Real>& cnorm = ResNormInfComp(alev, true);
+    Real norm = *std::max_element(cnorm.begin(), cnorm.end());
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, alev, 0);
+        ParallelAllReduce::Max(norm, ParallelContext::CommunicatorSub());
+    }
+    return norm;
+}
+
+// Computes multi-level masked inf-norm of Residual (res).
+Real
+MLMG::MLResNormInf (int alevmax, bool local)
+{
+    BL_PROFILE("MLMG::MLResNormInf()");
+    const Vector<Real>& cnorm = MLResNormInfComp(alevmax, true);
+    Real r = *std::max_element(cnorm.begin(), cnorm.end());
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, 0, 0);
+        ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    }
+    return r;
+}
+
+Real
+MLMG::MLDot (const Vector<MultiFab>& x, const Vector<MultiFab>& y, bool local)
+{
+    BL_PROFILE("MLMG::MLDot()");
+    const int ncomp = linop.getNComp();
+    Real r = 0.0;
+    for (int alev = 0; alev <= finest_amr_lev; ++alev)
+    {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, alev, 0, &x[alev]);
+        // Cell volume relative to the finest level
+        const Real* dx = linop.Geom(alev).CellSize();
+        const Real* dxf = linop.Geom(finest_amr_lev).CellSize();
+        const Real w = AMREX_D_TERM(dx[0]/dxf[0], *dx[1]/dxf[1], *dx[2]/dxf[2]);
+        if (fine_mask[alev]) {
+            r += w*MultiFab::Dot(*fine_mask[alev], x[alev], 0, y[alev], 0, ncomp, 0, true);
+        } else {
+            r += w*linop.xdoty(alev, 0, x[alev], y[alev], true);
+        }
+    }
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, 0, 0);
+        ParallelAllReduce::Sum(r, ParallelContext::CommunicatorSub());
+    }
+    return r;
+}
+
+// Computes multi-level masked inf-norm of v, using res as scratch space.
+Real
+MLMG::MLNormInf (const Vector<MultiFab>& v, bool local)
+{
+    const int ncomp = linop.getNComp();
+    for (int alev = 0; alev <= finest_amr_lev; ++alev) {
+        MultiFab::Copy(res[alev][0], v[alev], 0, 0, ncomp, 0);
+    }
+    return MLResNormInf(finest_amr_lev, local);
+}
+
+// Compute multi-level masked inf-norm of RHS (rhs).
+Real
+MLMG::MLRhsNormInf (bool local)
+{
+    BL_PROFILE("MLMG::MLRhsNormInf()");
+    const Vector<Real>& cnorm = MLRhsNormInfComp(true);
+    Real r = *std::max_element(cnorm.begin(), cnorm.end());
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, 0, 0);
+        ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    }
+    return r;
+}
+
+// Compute single-level masked inf-norm of each component of Residual (res).
+Vector<Real>
+MLMG::ResNormInfComp (int alev, bool local)
+{
     const int ncomp = linop.getNComp();
     const int mglev = 0;
-    Real norm = 0.0;
+    MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, alev, mglev, &res[alev][mglev]);
+    Vector<Real> norm(ncomp, 0.0);
     MultiFab* pmf = &(res[alev][mglev]);
 #ifdef AMREX_USE_EB
     if (linop.isCellCentered() && scratch[alev]) {
@@ -1034,41 +1803,45 @@ MLMG::ResNormInf (int alev, bool local)
 #endif
     for (int n = 0; n < ncomp; n++)
     {
-	Real newnorm = 0.0;
 	if (fine_mask[alev]) {
-            newnorm = pmf->norm0(*fine_mask[alev],n,0,true);
+            norm[n] = pmf->norm0(*fine_mask[alev],n,0,true);
 	} else {
-            newnorm = pmf->norm0(n,0,true);
+            norm[n] = pmf->norm0(n,0,true);
 	}
-        norm = std::max(norm, newnorm);
     }
-    if (!local) ParallelAllReduce::Max(norm, ParallelContext::CommunicatorSub());
+    if (!local) ParallelAllReduce::Max(norm.data(), ncomp, ParallelContext::CommunicatorSub());
     return norm;
 }
 
-// Computes multi-level masked inf-norm of Residual (res).
-Real
-MLMG::MLResNormInf (int alevmax, bool local)
+// Computes multi-level masked inf-norm of each component of Residual (res).
+Vector<Real>
+MLMG::MLResNormInfComp (int alevmax, bool local)
 {
-    BL_PROFILE("MLMG::MLResNormInf()");
-    Real r = 0.0;
+    const int ncomp = linop.getNComp();
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= alevmax; ++alev)
     {
-        r = std::max(r, ResNormInf(alev,true));
+        const Vector<Real>& rlev = ResNormInfComp(alev,true);
+        for (int n = 0; n < ncomp; ++n) {
+            r[n] = std::max(r[n], rlev[n]);
+        }
+    }
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, 0, 0);
+        ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
     return r;
 }
 
-// Compute multi-level masked inf-norm of RHS (rhs).
-Real
-MLMG::MLRhsNormInf (bool local)
+// Compute multi-level masked inf-norm of each component of RHS (rhs).
+Vector<Real>
+MLMG::MLRhsNormInfComp (bool local)
 {
-    BL_PROFILE("MLMG::MLRhsNormInf()");
     const int ncomp = linop.getNComp();
-    Real r = 0.0;
+    Vector<Real> r(ncomp, 0.0);
     for (int alev = 0; alev <= finest_amr_lev; ++alev)
     {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, alev, 0, &rhs[alev]);
         MultiFab* pmf = &(rhs[alev]);
 #ifdef AMREX_USE_EB
         if (linop.isCellCentered() && scratch[alev]) {
@@ -1088,13 +1861,16 @@ MLMG::MLRhsNormInf (bool local)
         for (int n=0; n<ncomp; ++n)
         {
             if (alev < finest_amr_lev) {
-                r = std::max(r, pmf->norm0(*fine_mask[alev],n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(*fine_mask[alev],n,0,true));
             } else {
-                r = std::max(r, pmf->norm0(n,0,true));
+                r[n] = std::max(r[n], pmf->norm0(n,0,true));
             }
         }
     }
-    if (!local) ParallelAllReduce::Max(r, ParallelContext::CommunicatorSub());
+    if (!local) {
+        MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::reduction, 0, 0);
+        ParallelAllReduce::Max(r.data(), ncomp, ParallelContext::CommunicatorSub());
+    }
     return r;
 }
 
@@ -1133,27 +1909,16 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
 
     timer.assign(ntimers, 0.0);
 
+    if (perf_stats) {
+        definePerfStats();
+        linop.setPerfStats(perf_stats.get());
+    }
+
     const int ncomp = linop.getNComp();
     int nghost = 0;
     if (cf_strategy == CFStrategy::ghostnodes) nghost = linop.getNGrow();
 
-    if (!linop_prepared) {
-        linop.prepareForSolve();
-        linop_prepared = true;
-    } else if (linop.needsUpdate()) {
-        linop.update();
-
-#ifdef AMREX_USE_HYPRE
-        hypre_solver.reset();
-        hypre_bndry.reset();
-        hypre_node_solver.reset();
-#endif
-
-#ifdef AMREX_USE_PETSC
-        petsc_solver.reset(); 
-        petsc_bndry.reset(); 
-#endif
-    }
+    prepareLinOp();
 
     sol.resize(namrlevs);
     sol_raii.resize(namrlevs);
@@ -1241,9 +2006,10 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
         for (int mglev = 0; mglev < nmglevs; ++mglev)
         {
             if (!solve_called) {
+                const int ngcor = std::max(ng, linop.getSmoothNGrow(alev,mglev));
                 cor[alev][mglev].reset(new MultiFab(res[alev][mglev].boxArray(),
                                                     res[alev][mglev].DistributionMap(),
-                                                    ncomp, ng, MFInfo(),
+                                                    ncomp, ngcor, MFInfo(),
                                                     *linop.Factory(alev,mglev)));
             }
             cor[alev][mglev]->setVal(0.0);
@@ -1317,6 +2083,46 @@ MLMG::prepareForSolve (const Vector<MultiFab*>& a_sol, const Vector<MultiFab con
     }
 }
 
+void
+MLMG::prepareLinOp ()
+{
+    if (!linop_prepared) {
+        linop.prepareForSolve();
+        linop_prepared = true;
+        ++linop.m_coeff_version;
+    } else if (linop.needsUpdate()) {
+        AMREX_ALWAYS_ASSERT_WITH_MESSAGE(!linop.isFrozen(),
+                                         "MLMG: coefficients of a frozen MLLinOp have been changed");
+        linop.update();
+        ++linop.m_coeff_version;
+    }
+
+    // The linop may be shared with another MLMG that has updated it.
+    if (linop_version != linop.coeffVersion())
+    {
+        if (linop_version >= 0)
+        {
+            lu_solver.reset();
+
+#ifdef AMREX_USE_HYPRE
+            hypre_solver.reset();
+            hypre_bndry.reset();
+            hypre_node_solver.reset();
+#endif
+
+#ifdef AMREX_USE_PETSC
+            petsc_solver.reset(); 
+            petsc_bndry.reset(); 
+#endif
+
+            // The coefficients of ns_linop are copied from linop.
+            ns_mlmg.reset();
+            ns_linop.reset();
+        }
+        linop_version = linop.coeffVersion();
+    }
+}
+
 void
 MLMG::prepareForNSolve ()
 {
@@ -1485,12 +2291,7 @@ MLMG::compResidual (const Vector<MultiFab*>& a_res, const Vector<MultiFab*>& a_s
         }
     }
 
-    if (!linop_prepared) {
-        linop.prepareForSolve();
-        linop_prepared = true;
-    } else if (linop.needsUpdate()) {
-        linop.update();
-    }
+    prepareLinOp();
     
     const auto& amrrr = linop.AMRRefRatio();
 
@@ -1567,12 +2368,7 @@ MLMG::apply (const Vector<MultiFab*>& out, const Vector<MultiFab*>& a_in)
         rh[alev].setVal(0.0);
     }
 
-    if (!linop_prepared) {
-        linop.prepareForSolve();
-        linop_prepared = true;
-    } else if (linop.needsUpdate()) {
-        linop.update();
-    }
+    prepareLinOp();
 
     for (int alev = 0; alev < namrlevs; ++alev) {
         linop.applyInhomogNeumannTerm(alev, rh[alev]);
@@ -1620,6 +2416,7 @@ MLMG::averageDownAndSync ()
     {
         for (int falev = finest_amr_lev; falev > 0; --falev)
         {
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::restriction, falev-1, 0, sol[falev]);
 #ifdef AMREX_USE_EB
             amrex::EB_average_down(*sol[falev], *sol[falev-1], 0, ncomp, amrrr[falev-1]);
 #else
@@ -1635,6 +2432,7 @@ MLMG::averageDownAndSync ()
         {
             const auto& fmf = *sol[falev];
             auto&       cmf = *sol[falev-1];
+            MLPerfStats::Timer perf(perf_stats.get(), MLPerfStats::restriction, falev-1, 0, &fmf);
 
             MultiFab tmpmf(amrex::coarsen(fmf.boxArray(), amrrr[falev-1]), fmf.DistributionMap(), ncomp, nghost);
             amrex::average_down(fmf, tmpmf, 0, ncomp, amrrr[falev-1]);
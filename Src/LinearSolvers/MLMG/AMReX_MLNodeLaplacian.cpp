@@ -136,6 +136,7 @@ void
 MLNodeLaplacian::setSigma (int amrlev, const MultiFab& a_sigma)
 {
     MultiFab::Copy(*m_sigma[amrlev][0][0], a_sigma, 0, 0, 1, 0);
+    m_needs_update = true;
 }
 
 void
@@ -1097,6 +1098,26 @@ MLNodeLaplacian::prepareForSolve ()
 #endif
 
     buildStencil();
+
+    computeChebyshevBounds();
+
+    m_needs_update = false;
+}
+
+void
+MLNodeLaplacian::update ()
+{
+    BL_PROFILE("MLNodeLaplacian::update()");
+
+    if (MLNodeLinOp::needsUpdate()) MLNodeLinOp::update();
+
+    averageDownCoeffs();
+
+    buildStencil();
+
+    computeChebyshevBounds();
+
+    m_needs_update = false;
 }
 
 void
@@ -129,12 +129,21 @@ MLNodeLinOp::apply (int amrlev, int mglev, MultiFab& out, MultiFab& in, BCMode b
 
 void
 MLNodeLinOp::smooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs,
-                     bool skip_fillboundary) const
+                     bool skip_fillboundary, int niter) const
 {
-    if (!skip_fillboundary) {
-        applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution);
+    if (useChebyshevSmoother()) {
+        chebyshevSmooth(amrlev, mglev, sol, rhs, niter);
+        nodalSync(amrlev, mglev, sol);
+        return;
+    }
+
+    for (int i = 0; i < niter; ++i) {
+        if (!skip_fillboundary) {
+            applyBC(amrlev, mglev, sol, BCMode::Homogeneous, StateMode::Solution);
+        }
+        Fsmooth(amrlev, mglev, sol, rhs);
+        skip_fillboundary = false;
     }
-    Fsmooth(amrlev, mglev, sol, rhs);
 }
 
 Real
@@ -320,7 +329,7 @@ MLNodeLinOp::buildMasks ()
         MLNodeLinOp_set_dot_mask(m_bottom_dot_mask, omask, geom, lobc, hibc, m_coarsening_strategy);
     }
 
-    if (m_is_bottom_singular)
+    // Also used by the Krylov solvers of MLMG on the coarsest AMR level
     {
         int amrlev = 0;
         int mglev = 0;
@@ -359,6 +368,8 @@ MLNodeLinOp::applyBC (int amrlev, int mglev, MultiFab& phi, BCMode/* bc_mode*/,
     const Box& nd_domain = amrex::surroundingNodes(geom.Domain());
 
     if (!skip_fillboundary) {
+        MLPerfStats::Timer perf(m_perf_stats, MLPerfStats::fillboundary, amrlev, mglev);
+        perf.addFillBoundaryBytes(phi, phi.nComp(), phi.nGrowVect(), geom.periodicity(), false);
         phi.FillBoundary(geom.periodicity());
     }
 
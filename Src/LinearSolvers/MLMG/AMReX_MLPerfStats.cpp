@@ -0,0 +1,181 @@
+#include <AMReX_MLPerfStats.H>
+#include <AMReX_ParallelContext.H>
+#include <AMReX_ParallelReduce.H>
+#include <AMReX_Utility.H>
+#include <ostream>
+
+namespace amrex {
+
+const char*
+MLPerfStats::phaseName (int phase) noexcept
+{
+    switch (phase) {
+    case smooth:        return "smooth";
+    case apply:         return "apply";
+    case restriction:   return "restriction";
+    case interpolation: return "interpolation";
+    case fillboundary:  return "fillboundary";
+    case reduction:     return "reduction";
+    case bottom:        return "bottom";
+    default:            return "unknown";
+    }
+}
+
+void
+MLPerfStats::define (const Vector<int>& num_mg_levels)
+{
+    m_entry.clear();
+    m_entry.resize(num_mg_levels.size());
+    for (int alev = 0; alev < num_mg_levels.size(); ++alev) {
+        m_entry[alev].resize(num_mg_levels[alev]);
+    }
+    m_nested = 0.0;
+}
+
+void
+MLPerfStats::reset ()
+{
+    for (auto& v : m_entry) {
+        for (auto& e : v) {
+            e = Entry();
+        }
+    }
+    m_nested = 0.0;
+}
+
+MLPerfStats::Timer::Timer (MLPerfStats* stats, Phase phase, int amrlev, int mglev,
+                           const FabArrayBase* mf)
+    : m_stats(stats), m_phase(phase), m_amrlev(amrlev), m_mglev(mglev)
+{
+    // Do nothing if the entries have not been defined for this level
+    if (m_stats && (m_amrlev >= m_stats->m_entry.size() ||
+                    m_mglev >= m_stats->m_entry[m_amrlev].size())) {
+        m_stats = nullptr;
+    }
+    if (m_stats) {
+        Entry& e = m_stats->m_entry[m_amrlev][m_mglev];
+        ++e.calls[m_phase];
+        if (mf) {
+            Long npts = 0;
+            for (int i : mf->IndexArray()) {
+                npts += mf->box(i).numPts();
+            }
+            e.cells[m_phase] += npts;
+        }
+        m_nested_start = m_stats->m_nested;
+        m_start = amrex::second();
+    }
+}
+
+MLPerfStats::Timer::~Timer ()
+{
+    if (m_stats) {
+        const double elapsed = amrex::second() - m_start;
+        const double nested = m_stats->m_nested - m_nested_start;
+        m_stats->m_entry[m_amrlev][m_mglev].time[m_phase] += elapsed - nested;
+        m_stats->m_nested = m_nested_start + elapsed;
+    }
+}
+
+void
+MLPerfStats::Timer::addFillBoundaryBytes (const FabArrayBase& mf, int ncomp, const IntVect& nghost,
+                                          const Periodicity& period, bool cross)
+{
+    if (m_stats == nullptr || ParallelContext::NProcsSub() == 1) return;
+    if (nghost.max() == 0) return;
+    const FabArrayBase::FB& fb = mf.getFB(nghost, period, cross);
+    Long npts = 0;
+    for (auto const& kv : *fb.m_SndTags) {
+        for (auto const& tag : kv.second) {
+            npts += tag.sbox.numPts();
+        }
+    }
+    m_stats->m_entry[m_amrlev][m_mglev].bytes += npts * ncomp * sizeof(Real);
+}
+
+void
+MLPerfStats::writeJSON (std::ostream& os, Long a_solve, int a_niters, Real a_solve_time) const
+{
+    const MPI_Comm comm = ParallelContext::CommunicatorSub();
+    const int nprocs = ParallelContext::NProcsSub();
+    const int ioproc = 0;
+
+    // All times, then the solve time
+    Vector<double> tmin, tmax, tsum;
+    // Calls, cells and bytes
+    Vector<Long> cmax, csum;
+    for (auto const& v : m_entry) {
+        for (auto const& e : v) {
+            for (int p = 0; p < nphases; ++p) {
+                tmin.push_back(e.time[p]);
+                cmax.push_back(e.calls[p]);
+                cmax.push_back(e.cells[p]);
+            }
+            cmax.push_back(e.bytes);
+        }
+    }
+    tmin.push_back(a_solve_time);
+    tmax = tmin;
+    tsum = tmin;
+    csum = cmax;
+    ParallelReduce::Min(tmin.data(), tmin.size(), ioproc, comm);
+    ParallelReduce::Max(tmax.data(), tmax.size(), ioproc, comm);
+    ParallelReduce::Sum(tsum.data(), tsum.size(), ioproc, comm);
+    ParallelReduce::Max(cmax.data(), cmax.size(), ioproc, comm);
+    ParallelReduce::Sum(csum.data(), csum.size(), ioproc, comm);
+
+    if (ParallelContext::MyProcSub() != ioproc) return;
+
+    auto write_time = [&] (int i) {
+        const double avg = tsum[i]/nprocs;
+        os << "\"time_min\":" << tmin[i] << ",\"time_avg\":" << avg
+           << ",\"time_max\":" << tmax[i]
+           << ",\"imbalance\":" << ((avg > 0.0) ? tmax[i]/avg : 1.0);
+    };
+
+    const auto old_flags = os.flags();
+    const auto old_prec = os.precision(8);
+
+    os << "{\"solve\":" << a_solve << ",\"nprocs\":" << nprocs
+       << ",\"iterations\":" << a_niters << ",";
+    os << "\"solve_time\":{";
+    write_time(tmin.size()-1);
+    os << "},\"levels\":[";
+
+    // Offsets of the entries in the time and count arrays
+    int it = 0, ic = 0;
+    bool first_level = true;
+    for (int alev = 0; alev < m_entry.size(); ++alev) {
+        for (int mglev = 0; mglev < m_entry[alev].size(); ++mglev) {
+            if (!first_level) os << ",";
+            first_level = false;
+            os << "{\"amrlev\":" << alev << ",\"mglev\":" << mglev << ",\"phases\":{";
+            bool first_phase = true;
+            for (int p = 0; p < nphases; ++p) {
+                const int icalls = ic + 2*p;
+                const int icells = ic + 2*p + 1;
+                const int ibytes = ic + 2*nphases;
+                if (cmax[icalls] == 0) continue;
+                if (!first_phase) os << ",";
+                first_phase = false;
+                os << "\"" << phaseName(p) << "\":{\"calls\":" << cmax[icalls] << ",";
+                write_time(it+p);
+                os << ",\"cells\":" << csum[icells] << ",\"cells_max\":" << cmax[icells];
+                if (p == fillboundary) {
+                    os << ",\"bytes\":" << csum[ibytes] << ",\"bytes_max\":" << cmax[ibytes];
+                }
+                os << "}";
+            }
+            os << "}}";
+            it += nphases;
+            ic += 2*nphases + 1;
+        }
+    }
+    os << "]}\n";
+    os.flush();
+
+    os.flags(old_flags);
+    os.precision(old_prec);
+}
+
+}
@@ -152,9 +152,22 @@ void
 MLPoisson::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, int redblack) const
 {
     BL_PROFILE("MLPoisson::Fsmooth()");
+    FsmoothImpl(amrlev, mglev, sol, rhs, redblack, false, 0);
+}
 
-    const auto& undrrelxr = m_undrrelxr[amrlev][mglev];
-    const auto& maskvals  = m_maskvals [amrlev][mglev];
+void
+MLPoisson::FsmoothDeep (int mglev, MultiFab& sol, const MultiFab& rhs, int redblack, int ngrow) const
+{
+    BL_PROFILE("MLPoisson::FsmoothDeep()");
+    FsmoothImpl(0, mglev, sol, rhs, redblack, true, ngrow);
+}
+
+void
+MLPoisson::FsmoothImpl (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, int redblack,
+                        bool deep, int ngrow) const
+{
+    const auto& undrrelxr = (deep) ? m_deep_undrrelxr[mglev] : m_undrrelxr[amrlev][mglev];
+    const auto& maskvals  = (deep) ? m_deep_maskvals[mglev]  : m_maskvals [amrlev][mglev];
 
     OrientationIter oitr;
 
@@ -209,8 +222,10 @@ MLPoisson::Fsmooth (int amrlev, int mglev, MultiFab& sol, const MultiFab& rhs, i
 #endif
 #endif
 
-	const Box& tbx = mfi.tilebox();
-        const Box& vbx = mfi.validbox();
+        // In a deep pass, the boxes grown by the ghost cells take the
+        // place of the valid boxes.
+        const Box& vbx = (deep) ? m_deep_grids[mglev][mfi.index()] : mfi.validbox();
+        const Box& tbx = (deep) ? mfi.growntilebox(ngrow) & vbx : mfi.tilebox();
         const auto& solnfab = sol.array(mfi);
         const auto& rhsfab  = rhs.array(mfi);
 
@@ -390,6 +390,18 @@ MacProjector::setOptions ()
     {
         m_mlmg->setBottomSolver(MLMG::BottomSolver::cgbicg);
     }
+    else if (bottom_solver == "pipebicg")
+    {
+        m_mlmg->setBottomSolver(MLMG::BottomSolver::pipebicgstab);
+    }
+    else if (bottom_solver == "pipecg")
+    {
+        m_mlmg->setBottomSolver(MLMG::BottomSolver::pipecg);
+    }
+    else if (bottom_solver == "lu")
+    {
+        m_mlmg->setBottomSolver(MLMG::BottomSolver::lu);
+    }
     else if (bottom_solver == "hypre")
     {
 #ifdef AMREX_USE_HYPRE
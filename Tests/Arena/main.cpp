@@ -0,0 +1,182 @@
+#include <AMReX.H>
+#include <AMReX_CArena.H>
+#include <AMReX_SArena.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Utility.H>
+
+#include <atomic>
+#include <cstring>
+#include <random>
+#include <thread>
+
+using namespace amrex;
+
+void main_main ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    main_main();
+
+    amrex::Finalize();
+}
+
+namespace {
+
+struct Slot
+{
+    unsigned char* p = nullptr;
+    std::size_t n = 0;
+};
+
+void fill (Slot& s, unsigned char v)
+{
+    std::memset(s.p, v, s.n);
+}
+
+bool check (const Slot& s, unsigned char v)
+{
+    return s.n == 0 || (s.p[0] == v && s.p[s.n/2] == v && s.p[s.n-1] == v);
+}
+
+//
+// Random alloc/free churn on a fixed number of live blocks.  Every block is
+// filled and checked before it is freed.
+//
+bool churn (Arena* arena, int nslots, Long nops, int max_size, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> slot_dist(0, nslots-1);
+    std::uniform_int_distribution<int> size_dist(1, max_size);
+
+    Vector<Slot> slots(nslots);
+    bool ok = true;
+    for (Long i = 0; i < nops; ++i)
+    {
+        Slot& s = slots[slot_dist(gen)];
+        const unsigned char v = static_cast<unsigned char>(&s - slots.data());
+        if (s.p) {
+            ok = ok && check(s, v);
+            arena->free(s.p);
+        }
+        s.n = size_dist(gen);
+        s.p = static_cast<unsigned char*>(arena->alloc(s.n));
+        fill(s, v);
+    }
+    for (auto& s : slots) {
+        ok = ok && check(s, static_cast<unsigned char>(&s - slots.data()));
+        arena->free(s.p);
+    }
+    return ok;
+}
+
+//
+// One thread allocates and another frees, through a ring of nslots blocks.
+//
+bool producer_consumer (Arena* arena, int nslots, Long nops, int max_size)
+{
+    Vector<Slot> slots(nslots);
+    std::atomic<Long> produced{0};
+    std::atomic<Long> consumed{0};
+    bool ok = true;
+
+    std::thread producer([&] () {
+        std::mt19937 gen(7);
+        std::uniform_int_distribution<int> size_dist(1, max_size);
+        for (Long k = 0; k < nops; ++k) {
+            while (k - consumed.load(std::memory_order_acquire) >= nslots) {
+                std::this_thread::yield();
+            }
+            Slot& s = slots[k%nslots];
+            s.n = size_dist(gen);
+            s.p = static_cast<unsigned char*>(arena->alloc(s.n));
+            fill(s, static_cast<unsigned char>(k));
+            produced.store(k+1, std::memory_order_release);
+        }
+    });
+
+    std::thread consumer([&] () {
+        for (Long k = 0; k < nops; ++k) {
+            while (produced.load(std::memory_order_acquire) <= k) {
+                std::this_thread::yield();
+            }
+            Slot& s = slots[k%nslots];
+            ok = check(s, static_cast<unsigned char>(k)) && ok;
+            arena->free(s.p);
+            consumed.store(k+1, std::memory_order_release);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+    return ok;
+}
+
+}
+
+void main_main ()
+{
+    int nslots = 4096;
+    Long nops = 200000;
+    int max_size = 4096;
+    int nthreads = 2;
+    {
+        ParmParse pp;
+        pp.query("nslots", nslots);
+        pp.query("nops", nops);
+        pp.query("max_size", max_size);
+        pp.query("nthreads", nthreads);
+    }
+
+    amrex::Print() << "Arena microbenchmark: nslots = " << nslots << ", nops = " << nops
+                   << ", max_size = " << max_size << ", nthreads = " << nthreads << "\n";
+
+    for (int itype = 0; itype < 2; ++itype)
+    {
+        std::unique_ptr<Arena> arena;
+        std::string name;
+        if (itype == 0) {
+            arena.reset(new CArena);
+            name = "CArena";
+        } else {
+            arena.reset(new SArena);
+            name = "SArena";
+        }
+
+        bool ok = true;
+
+        double t0 = amrex::second();
+        ok = churn(arena.get(), nslots, nops, max_size, 42) && ok;
+        double t_serial = amrex::second() - t0;
+
+        t0 = amrex::second();
+        Vector<std::thread> threads;
+        Vector<int> thread_ok(nthreads, 1);
+        for (int t = 0; t < nthreads; ++t) {
+            threads.emplace_back([&, t] () {
+                thread_ok[t] = churn(arena.get(), nslots, nops/nthreads, max_size, t+1);
+            });
+        }
+        for (auto& th : threads) {
+            th.join();
+        }
+        for (int t = 0; t < nthreads; ++t) {
+            ok = ok && thread_ok[t];
+        }
+        double t_threads = amrex::second() - t0;
+
+        t0 = amrex::second();
+        ok = producer_consumer(arena.get(), nslots, nops/4, max_size) && ok;
+        double t_remote = amrex::second() - t0;
+
+        amrex::Print() << name << ": serial " << t_serial << " s, "
+                       << nthreads << " threads " << t_threads << " s, "
+                       << "cross-thread free " << t_remote << " s\n";
+
+        if (!ok) {
+            amrex::Abort(name + ": memory corruption detected");
+        }
+    }
+}
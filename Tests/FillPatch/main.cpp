@@ -0,0 +1,158 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_FillPatchUtil.H>
+#include <AMReX_PhysBCFunct.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+void main_main ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    main_main();
+
+    amrex::Finalize();
+}
+
+namespace {
+
+void fill (MultiFab& mf, Real s)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), mf.nComp(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = s*(std::sin(0.1*i) + std::cos(0.07*j) + 0.01*k + n);
+        });
+    }
+}
+
+}
+
+//
+// FillPatchTwoLevels_nowait followed by FillPatchTwoLevels_finish has to
+// give the same result, bit for bit, as FillPatchTwoLevels.
+//
+void main_main ()
+{
+    int n_cell = 16;
+    int max_grid_size = 8;
+    int ncomp = 2;
+    int nghost = 2;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("max_grid_size", max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("nghost", nghost);
+    }
+
+    const int n = n_cell;
+    const IntVect ratio(2);
+    const RealBox rb({AMREX_D_DECL(0.,0.,0.)}, {AMREX_D_DECL(1.,1.,1.)});
+    Vector<BCRec> bcs(ncomp);
+    PhysBCFunctNoOp bc;
+
+    int nfail = 0;
+    for (int nodal = 0; nodal < 2; ++nodal) {
+    for (int periodic = 0; periodic < 2; ++periodic) {
+    for (int ntimes = 1; ntimes <= 2; ++ntimes) {
+    // 0: fill the fine source itself, 1: its layout, 2: another layout
+    for (int layout = 0; layout < 3; ++layout) {
+    for (int cache = 0; cache < 2; ++cache)
+    {
+        if (layout == 0 && ntimes == 2) continue;
+
+        FabArrayBase::fp_scratch_cache = cache;
+
+        const Array<int,AMREX_SPACEDIM> is_per{AMREX_D_DECL(periodic,periodic,periodic)};
+        Geometry cgeom(Box(IntVect(0), IntVect(n-1)), rb, 0, is_per);
+        Geometry fgeom(amrex::refine(cgeom.Domain(), ratio), rb, 0, is_per);
+
+        const IndexType typ = nodal ? IndexType::TheNodeType() : IndexType::TheCellType();
+        BoxArray cba(cgeom.Domain());
+        cba.maxSize(max_grid_size);
+        cba.convert(typ);
+        BoxList fbl;
+        fbl.push_back(Box(IntVect(0), IntVect(n-1)));
+        fbl.push_back(Box(IntVect(n), IntVect(2*n-1)));
+        fbl.push_back(Box(IntVect(AMREX_D_DECL(n+n/2,0,0)), IntVect(AMREX_D_DECL(2*n-1,n/2-1,n/2-1))));
+        BoxArray fba(fbl);
+        fba.maxSize(max_grid_size);
+        fba.convert(typ);
+        DistributionMapping cdm(cba);
+        DistributionMapping fdm(fba);
+
+        BoxArray dba = fba;
+        if (layout == 2) dba.maxSize(max_grid_size/2);
+        DistributionMapping ddm = (layout == 2) ? DistributionMapping(dba) : fdm;
+
+        MultiFab c0(cba, cdm, ncomp, 0);
+        MultiFab c1(cba, cdm, ncomp, 0);
+        MultiFab f0(fba, fdm, ncomp, nghost);
+        MultiFab f1(fba, fdm, ncomp, 0);
+        fill(c0, 1.0);
+        fill(c1, 2.0);
+        fill(f1, 2.5);
+
+        Interpolater* mapper = nodal ? static_cast<Interpolater*>(&node_bilinear_interp)
+                                     : static_cast<Interpolater*>(&cell_cons_interp);
+        const Vector<MultiFab*> fsrc = (ntimes == 1) ? Vector<MultiFab*>{&f0}
+                                                     : Vector<MultiFab*>{&f0,&f1};
+        const Vector<Real> ftime = (ntimes == 1) ? Vector<Real>{0.3} : Vector<Real>{0.,1.};
+
+        MultiFab result[2];
+        for (int nowait = 0; nowait < 2; ++nowait)
+        {
+            fill(f0, 1.5);
+            MultiFab* dst = &f0;
+            if (layout == 0) {
+                f0.setBndry(-7.0);
+            } else {
+                result[nowait].define(dba, ddm, ncomp, nghost);
+                result[nowait].setVal(-7.0);
+                dst = &result[nowait];
+            }
+
+            if (nowait) {
+                auto handle = FillPatchTwoLevels_nowait(*dst, 0.3, {&c0,&c1}, {0.,1.}, fsrc, ftime,
+                                                        0, 0, ncomp, cgeom, fgeom, bc, 0, bc, 0,
+                                                        ratio, mapper, bcs, 0);
+                FillPatchTwoLevels_finish(handle);
+            } else {
+                FillPatchTwoLevels(*dst, 0.3, {&c0,&c1}, {0.,1.}, fsrc, ftime,
+                                   0, 0, ncomp, cgeom, fgeom, bc, 0, bc, 0,
+                                   ratio, mapper, bcs, 0);
+            }
+
+            if (layout == 0) {
+                result[nowait].define(fba, fdm, ncomp, nghost);
+                MultiFab::Copy(result[nowait], f0, 0, 0, ncomp, nghost);
+            }
+        }
+
+        MultiFab::Subtract(result[1], result[0], 0, 0, ncomp, nghost);
+        Real diff = 0.0;
+        for (int icomp = 0; icomp < ncomp; ++icomp) {
+            diff = std::max(diff, result[1].norm0(icomp, nghost));
+        }
+        const bool ok = (diff == 0.0);
+        nfail += !ok;
+
+        amrex::Print() << "nodal " << nodal << ", periodic " << periodic
+                       << ", ntimes " << ntimes << ", layout " << layout
+                       << ", scratch cache " << cache
+                       << ": max diff " << diff << (ok ? "" : "  FAILED") << "\n";
+    }}}}}
+
+    if (nfail > 0) {
+        amrex::Abort("FillPatchTwoLevels_nowait differs from FillPatchTwoLevels");
+    }
+}
@@ -0,0 +1,123 @@
+// Cells updated per second by one core with the red-black Gauss-Seidel
+// kernels of MLABecLaplacian: abec_gsrb, which is used on GPUs, and
+// abec_gsrb_simd, which is used on CPUs.
+
+#include <AMReX.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_IArrayBox.H>
+#include <AMReX_MLABecLap_K.H>
+
+using namespace amrex;
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc, argv);
+    {
+        int n_cell = 128;
+        int nsweeps = 20;
+        {
+            ParmParse pp;
+            pp.query("n_cell", n_cell);
+            pp.query("nsweeps", nsweeps);
+        }
+
+        const Box vbx(IntVect(0), IntVect(n_cell-1));
+        BoxArray ba(vbx);
+        DistributionMapping dm(ba);
+
+        MultiFab rhs(ba, dm, 1, 0);
+        MultiFab acoef(ba, dm, 1, 0);
+        Array<MultiFab,AMREX_SPACEDIM> bcoef;
+        for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+            bcoef[idim].define(amrex::convert(ba,IntVect::TheDimensionVector(idim)), dm, 1, 0);
+        }
+        // Smooth, varying coefficients
+        const Real dx = 1.0/n_cell;
+        for (MFIter mfi(rhs); mfi.isValid(); ++mfi) {
+            auto const& r = rhs.array(mfi);
+            auto const& a = acoef.array(mfi);
+            amrex::LoopOnCpu(mfi.validbox(), [&] (int i, int j, int k)
+            {
+                r(i,j,k) = std::sin(6.0*i*dx) * std::cos(4.0*j*dx) + k*dx;
+                a(i,j,k) = 1.0 + 0.5*std::sin(3.0*(i+j+k)*dx);
+            });
+            for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                auto const& b = bcoef[idim].array(mfi);
+                amrex::LoopOnCpu(amrex::surroundingNodes(mfi.validbox(),idim),
+                [&] (int i, int j, int k)
+                {
+                    b(i,j,k) = 1.0 + 0.5*std::cos(5.0*(i-j+k)*dx);
+                });
+            }
+        }
+
+        // Boundary masks and coefficients, so that the faces of the box
+        // take the same branches as physical boundaries.
+        IArrayBox mask(amrex::grow(vbx,1));
+        mask.setVal<RunOn::Host>(1);
+        FArrayBox fcoef(vbx);
+        fcoef.setVal<RunOn::Host>(0.1);
+        auto const& m = mask.const_array();
+        auto const& f = fcoef.const_array();
+
+        const Real alpha = 1.0;
+        AMREX_D_TERM(const Real dhx = dx*dx;,
+                     const Real dhy = dx*dx;,
+                     const Real dhz = dx*dx;);
+
+        Vector<MultiFab> phi(2);
+        Vector<double> t(2);
+        for (int kernel = 0; kernel < 2; ++kernel)
+        {
+            phi[kernel].define(ba, dm, 1, 1);
+            phi[kernel].setVal(0.0);
+
+            const double t0 = amrex::second();
+            for (int sweep = 0; sweep < nsweeps; ++sweep) {
+                for (int redblack = 0; redblack < 2; ++redblack) {
+                    for (MFIter mfi(phi[kernel],true); mfi.isValid(); ++mfi)
+                    {
+                        const Box& tbx = mfi.tilebox();
+                        auto const& p = phi[kernel].array(mfi);
+                        auto const& r = rhs.const_array(mfi);
+                        auto const& a = acoef.const_array(mfi);
+                        AMREX_D_TERM(auto const& bx = bcoef[0].const_array(mfi);,
+                                     auto const& by = bcoef[1].const_array(mfi);,
+                                     auto const& bz = bcoef[2].const_array(mfi););
+                        if (kernel == 0) {
+                            abec_gsrb(tbx, p, r, alpha, a,
+                                      AMREX_D_DECL(dhx, dhy, dhz),
+                                      AMREX_D_DECL(bx, by, bz),
+                                      AMREX_D_DECL(m,m,m), AMREX_D_DECL(m,m,m),
+                                      AMREX_D_DECL(f,f,f), AMREX_D_DECL(f,f,f),
+                                      vbx, redblack, 1);
+                        } else {
+#if (AMREX_SPACEDIM > 1)
+                            abec_gsrb_simd(tbx, p, r, alpha, a,
+                                           AMREX_D_DECL(dhx, dhy, dhz),
+                                           AMREX_D_DECL(bx, by, bz),
+                                           AMREX_D_DECL(m,m,m), AMREX_D_DECL(m,m,m),
+                                           AMREX_D_DECL(f,f,f), AMREX_D_DECL(f,f,f),
+                                           vbx, redblack, 1);
+#endif
+                        }
+                    }
+                }
+            }
+            t[kernel] = amrex::second() - t0;
+        }
+
+        MultiFab::Subtract(phi[1], phi[0], 0, 0, 1, 0);
+
+        const double ncells = double(vbx.numPts()) * nsweeps;
+        amrex::Print() << "n_cell = " << n_cell << ", nsweeps = " << nsweeps << "\n"
+                       << "abec_gsrb:      " << t[0] << " s, "
+                       << ncells/t[0]*1.e-6 << " Mcells/s\n"
+                       << "abec_gsrb_simd: " << t[1] << " s, "
+                       << ncells/t[1]*1.e-6 << " Mcells/s, speedup "
+                       << t[0]/t[1] << "\n"
+                       << "max difference: " << phi[1].norm0() << "\n";
+    }
+    amrex::Finalize();
+}
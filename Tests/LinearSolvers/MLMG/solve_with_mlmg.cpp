@@ -20,6 +20,8 @@ static int linop_maxorder = 2;
 static bool agglomeration = false;
 static bool consolidation = false;
 static int  use_hypre = 0;
+static int  smooth_ngrow = 0;
+static int  chebyshev_degree = 0;
 }
 
 void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
@@ -44,6 +46,8 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
     pp.query("agglomeration", agglomeration);
     pp.query("consolidation", consolidation);
     pp.query("use_hypre", use_hypre);
+    pp.query("smooth_ngrow", smooth_ngrow);
+    pp.query("chebyshev_degree", chebyshev_degree);
     pp.query("tol_rel", tol_rel);
     pp.query("tol_abs", tol_abs);
   }
@@ -52,6 +56,8 @@ void solve_with_mlmg(const Vector<Geometry>& geom, int ref_ratio,
   info.setAgglomeration(agglomeration);
   info.setConsolidation(consolidation);
   info.setMaxCoarseningLevel(max_coarsening_level);
+  info.setSmoothNGrow(smooth_ngrow);
+  info.setChebyshevDegree(chebyshev_degree);
 
   const int nlevels = geom.size();
 
@@ -0,0 +1,118 @@
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+
+#include <algorithm>
+
+using namespace amrex;
+
+void main_main ();
+
+int main (int argc, char* argv[])
+{
+    amrex::Initialize(argc,argv);
+
+    main_main();
+
+    amrex::Finalize();
+}
+
+namespace {
+
+void fill (MultiFab& mf, Real s)
+{
+    for (MFIter mfi(mf); mfi.isValid(); ++mfi) {
+        auto const& a = mf.array(mfi);
+        amrex::ParallelFor(mfi.validbox(), mf.nComp(),
+        [=] AMREX_GPU_DEVICE (int i, int j, int k, int n) noexcept
+        {
+            a(i,j,k,n) = s*(std::sin(0.1*i) + std::cos(0.07*j) + 0.01*k + n);
+        });
+    }
+}
+
+}
+
+//
+// FabArray::ParallelCopyLinComb (blocking and nowait) has to give the same
+// result, bit for bit, as MultiFab::LinComb followed by ParallelCopy.
+//
+void main_main ()
+{
+    int n_cell = 32;
+    int src_max_grid_size = 8;
+    int dst_max_grid_size = 12;
+    int ncomp = 3;
+    int nghost = 2;
+    {
+        ParmParse pp;
+        pp.query("n_cell", n_cell);
+        pp.query("src_max_grid_size", src_max_grid_size);
+        pp.query("dst_max_grid_size", dst_max_grid_size);
+        pp.query("ncomp", ncomp);
+        pp.query("nghost", nghost);
+    }
+
+    const Real a = 0.3;
+    const Real b = 0.7;
+    const Box domain(IntVect(0), IntVect(n_cell-1));
+    const int dcomp = 1;
+    const IntVect ng(nghost);
+
+    int nfail = 0;
+    for (int nodal = 0; nodal < 2; ++nodal) {
+    for (int periodic = 0; periodic < 2; ++periodic) {
+    for (int same_layout = 0; same_layout < 2; ++same_layout) {
+    for (int nowait = 0; nowait < 2; ++nowait)
+    {
+        const IndexType typ = nodal ? IndexType::TheNodeType() : IndexType::TheCellType();
+        const Periodicity period = periodic ? Periodicity(IntVect(n_cell)) : Periodicity::NonPeriodic();
+
+        BoxArray sba(domain);
+        sba.maxSize(src_max_grid_size);
+        sba.convert(typ);
+        DistributionMapping sdm(sba);
+
+        BoxArray dba(domain);
+        dba.maxSize(same_layout ? src_max_grid_size : dst_max_grid_size);
+        dba.convert(typ);
+        DistributionMapping ddm = same_layout ? sdm : DistributionMapping(dba);
+
+        MultiFab src1(sba, sdm, ncomp, 0);
+        MultiFab src2(sba, sdm, ncomp, 0);
+        fill(src1, 1.1);
+        fill(src2, 2.3);
+
+        MultiFab tmp(sba, sdm, ncomp, 0);
+        MultiFab::LinComb(tmp, a, src1, 0, b, src2, 0, 0, ncomp, 0);
+        MultiFab dst_ref(dba, ddm, ncomp+dcomp, ng);
+        dst_ref.setVal(-7.0);
+        dst_ref.ParallelCopy(tmp, 0, dcomp, ncomp, IntVect(0), ng, period);
+
+        MultiFab dst(dba, ddm, ncomp+dcomp, ng);
+        dst.setVal(-7.0);
+        if (nowait) {
+            dst.ParallelCopyLinComb_nowait(a, src1, b, src2, 0, dcomp, ncomp, IntVect(0), ng, period);
+            dst.ParallelCopy_finish();
+        } else {
+            dst.ParallelCopyLinComb(a, src1, b, src2, 0, dcomp, ncomp, IntVect(0), ng, period);
+        }
+
+        MultiFab::Subtract(dst, dst_ref, 0, 0, ncomp+dcomp, ng);
+        Real diff = 0.0;
+        for (int n = 0; n < ncomp+dcomp; ++n) {
+            diff = std::max(diff, dst.norm0(n, nghost));
+        }
+        const bool ok = (diff == 0.0);
+        nfail += !ok;
+
+        amrex::Print() << "nodal " << nodal << ", periodic " << periodic
+                       << ", same layout " << same_layout << ", nowait " << nowait
+                       << ": max diff " << diff << (ok ? "" : "  FAILED") << "\n";
+    }}}}
+
+    if (nfail > 0) {
+        amrex::Abort("ParallelCopyLinComb differs from LinComb and ParallelCopy");
+    }
+}
@@ -245,6 +245,10 @@ if (AMReX_HDF5_ASYNC)
    message(FATAL_ERROR "\nAMReX_HDF5_ASYNC not yet supported\n")
 endif ()
 
+# zlib
+option(AMReX_ZLIB "Enable zlib compression of VisMF data" OFF)
+print_option(AMReX_ZLIB)
+
 
 #
 # Miscellanoues options  =====================================================
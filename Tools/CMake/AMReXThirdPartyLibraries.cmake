@@ -19,6 +19,15 @@ if (AMReX_HDF5)
 endif ()
 
 
+#
+# zlib
+#
+if (AMReX_ZLIB)
+    find_package(ZLIB REQUIRED)
+    target_link_libraries( amrex PUBLIC ZLIB::ZLIB )
+endif ()
+
+
 #
 # Sensei
 #
@@ -168,4 +168,9 @@ function ( set_amrex_defines )
    add_amrex_define(AMREX_USE_HDF5 NO_LEGACY IF AMReX_HDF5)
    add_amrex_define(AMREX_USE_HDF5_ASYNC NO_LEGACY IF AMReX_HDF5_ASYNC)
 
+   #
+   # zlib
+   #
+   add_amrex_define(AMREX_USE_ZLIB NO_LEGACY IF AMReX_ZLIB)
+
 endfunction ()